@@ -0,0 +1,169 @@
+#include "FastEngine/C_random.hpp"
+#include "FastEngine/extra/extra_pathFinding.hpp"
+#include "SDL.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "../client/hierarchicalPathfinder.hpp"
+
+/*
+ * Path finding benchmark, the hierarchical path finder against fge::AStar::Generator.
+ *
+ * A random map (open ground with blocking blobs, like the water and the depth objects of the real map) is generated
+ * for every size, the same random walkable pairs are queried with both path finders and we report the average
+ * time per query, the number of paths found and the average path length.
+ */
+
+namespace
+{
+
+struct QueryResult
+{
+    std::chrono::nanoseconds _time{0};
+    std::size_t _found = 0;
+    std::size_t _length = 0;
+};
+
+std::vector<uint8_t> GenerateMap(fge::Vector2size const& size)
+{
+    std::vector<uint8_t> walkable(size.x * size.y, 1);
+
+    auto const blobCount = size.x * size.y / 256;
+    for (std::size_t i = 0; i < blobCount; ++i)
+    {
+        auto const centerX = fge::_random.range<std::size_t>(0, size.x - 1);
+        auto const centerY = fge::_random.range<std::size_t>(0, size.y - 1);
+        auto const radius = fge::_random.range<std::size_t>(1, 5);
+
+        for (std::size_t y = centerY > radius ? centerY - radius : 0; y <= std::min(centerY + radius, size.y - 1); ++y)
+        {
+            for (std::size_t x = centerX > radius ? centerX - radius : 0; x <= std::min(centerX + radius, size.x - 1);
+                 ++x)
+            {
+                walkable[y * size.x + x] = 0;
+            }
+        }
+    }
+
+    return walkable;
+}
+
+fge::Vector2size RandomWalkableCell(std::vector<uint8_t> const& walkable, fge::Vector2size const& size)
+{
+    while (true)
+    {
+        fge::Vector2size const cell{fge::_random.range<std::size_t>(0, size.x - 1),
+                                    fge::_random.range<std::size_t>(0, size.y - 1)};
+        if (walkable[cell.y * size.x + cell.x] != 0)
+        {
+            return cell;
+        }
+    }
+}
+
+void RunBenchmark(std::size_t mapSize, std::size_t queryCount)
+{
+    fge::Vector2size const size{mapSize, mapSize};
+    auto walkable = GenerateMap(size);
+
+    std::vector<std::pair<fge::Vector2size, fge::Vector2size>> queries(queryCount);
+    for (auto& query: queries)
+    {
+        query = {RandomWalkableCell(walkable, size), RandomWalkableCell(walkable, size)};
+    }
+
+    //fge::AStar::Generator
+    fge::AStar::Generator generator;
+    generator.setWorldSize({static_cast<int>(mapSize), static_cast<int>(mapSize)});
+    generator.setDiagonalMovement(false);
+    for (std::size_t y = 0; y < size.y; ++y)
+    {
+        for (std::size_t x = 0; x < size.x; ++x)
+        {
+            if (walkable[y * size.x + x] == 0)
+            {
+                generator.addCollision({static_cast<int>(x), static_cast<int>(y)});
+            }
+        }
+    }
+
+    QueryResult aStar;
+    for (auto const& [from, to]: queries)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        auto const path = generator.findPath({static_cast<int>(from.x), static_cast<int>(from.y)},
+                                             {static_cast<int>(to.x), static_cast<int>(to.y)});
+        aStar._time += std::chrono::steady_clock::now() - start;
+
+        //The generator returns at least the start when there is no path
+        if (!path.empty() && path.front() == fge::Vector2i{static_cast<int>(to.x), static_cast<int>(to.y)})
+        {
+            ++aStar._found;
+            aStar._length += path.size();
+        }
+    }
+
+    //HierarchicalPathfinder
+    HierarchicalPathfinder pathfinder;
+    auto const buildStart = std::chrono::steady_clock::now();
+    pathfinder.build(size, std::move(walkable));
+    auto const buildTime = std::chrono::steady_clock::now() - buildStart;
+
+    QueryResult hpa;
+    for (auto const& [from, to]: queries)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        auto const path = pathfinder.findPath(from, to);
+        hpa._time += std::chrono::steady_clock::now() - start;
+
+        if (!path.empty())
+        {
+            ++hpa._found;
+            hpa._length += path.size();
+        }
+    }
+
+    auto const averageUs = [queryCount](QueryResult const& result) {
+        return std::chrono::duration<double, std::micro>(result._time).count() / static_cast<double>(queryCount);
+    };
+    auto const averageLength = [](QueryResult const& result) {
+        return result._found == 0 ? 0.0 : static_cast<double>(result._length) / static_cast<double>(result._found);
+    };
+
+    std::cout << std::fixed << std::setprecision(2) << std::setw(8) << mapSize << std::setw(16)
+              << std::chrono::duration<double, std::milli>(buildTime).count() << std::setw(10)
+              << pathfinder.getNodeCount() << std::setw(16) << averageUs(aStar) << std::setw(16) << averageUs(hpa)
+              << std::setw(12) << aStar._found << std::setw(12) << hpa._found << std::setw(12) << averageLength(aStar)
+              << std::setw(12) << averageLength(hpa) << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t queryCount = 200;
+    if (argc > 1)
+    {
+        queryCount = std::max<std::size_t>(1, std::strtoull(argv[1], nullptr, 10));
+    }
+
+    std::cout << "Path finding benchmark, " << queryCount << " queries per map\n";
+    std::cout << std::setw(8) << "size" << std::setw(16) << "hpa build ms" << std::setw(10) << "nodes"
+              << std::setw(16) << "astar us/query" << std::setw(16) << "hpa us/query" << std::setw(12)
+              << "astar found" << std::setw(12) << "hpa found" << std::setw(12) << "astar len" << std::setw(12)
+              << "hpa len" << "\n";
+
+    for (std::size_t const mapSize: {64, 128, 256, 512})
+    {
+        RunBenchmark(mapSize, queryCount);
+    }
+
+    SDL_Quit();
+
+    return 0;
+}
@@ -0,0 +1,225 @@
+#include "FastEngine/C_random.hpp"
+#include "FastEngine/manager/reg_manager.hpp"
+#include "FastEngine/network/C_server.hpp"
+#include "SDL.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "../server/scene.hpp"
+
+/*
+ * In-process benchmark of the server tick.
+ *
+ * No socket is opened, synthetic authenticated clients are created and their return packets are directly injected
+ * into the scene handlers. Every tick does what the server main loop does (handlers, clients checkup, update,
+ * pack/send) and we report the time, the bytes pushed per client and the allocations.
+ */
+
+namespace
+{
+
+std::atomic_size_t gAllocationCount = 0;
+
+struct SyntheticClient
+{
+    fge::net::Identity _identity;
+    fge::net::ClientSharedPtr _client;
+    fge::Vector2f _position;
+};
+
+struct TickResult
+{
+    std::chrono::nanoseconds _simulation{0};
+    std::chrono::nanoseconds _send{0};
+    std::size_t _bytes = 0;
+    std::size_t _allocations = 0;
+};
+
+std::size_t PopPendingPackets(SyntheticClient& syntheticClient)
+{
+    std::size_t bytes = 0;
+    while (!syntheticClient._client->isPendingPacketsEmpty())
+    {
+        auto packet = syntheticClient._client->popPacket();
+        bytes += packet->packet().getDataSize();
+    }
+    return bytes;
+}
+
+TickResult RunTick(Scene& scene,
+                   fge::net::ClientList& clients,
+                   std::vector<SyntheticClient>& syntheticClients,
+                   fge::Scene& clientScene)
+{
+    TickResult result;
+    fge::Event event;
+
+    //Build the return packets like a client would do
+    std::vector<fge::net::Packet> returnPackets(syntheticClients.size());
+    for (std::size_t i = 0; i < syntheticClients.size(); ++i)
+    {
+        auto& syntheticClient = syntheticClients[i];
+        syntheticClient._position.x += fge::_random.range(-1.0f, 1.0f);
+        syntheticClient._position.y += fge::_random.range(-1.0f, 1.0f);
+
+        returnPackets[i] << syntheticClient._position << fge::Vector2i{0, 1}
+                         << static_cast<Player::Stats_t>(Player::States::WALKING);
+        clientScene.packNeededUpdate(returnPackets[i]);
+    }
+
+    gAllocationCount = 0;
+    auto const simulationStart = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < syntheticClients.size(); ++i)
+    {
+        scene.onClientReturnPacket(syntheticClients[i]._client, syntheticClients[i]._identity, returnPackets[i]);
+    }
+
+    scene.clientsCheckup(clients);
+    scene.update(event, std::chrono::milliseconds{F_TICK_TIME});
+    scene.submitTick();
+    clients.clearClientEvent();
+
+    auto const sendStart = std::chrono::steady_clock::now();
+    scene.getSendPipeline().waitIdle();
+    auto const sendEnd = std::chrono::steady_clock::now();
+
+    result._allocations = gAllocationCount;
+    result._simulation = sendStart - simulationStart;
+    result._send = sendEnd - sendStart;
+
+    for (auto& syntheticClient: syntheticClients)
+    {
+        result._bytes += PopPendingPackets(syntheticClient);
+    }
+
+    return result;
+}
+
+void RunBenchmark(std::size_t playerCount, std::size_t tickCount)
+{
+    fge::net::ServerSideNetUdp network;
+
+    auto scene = std::make_unique<Scene>();
+    scene->getSendPipeline().start({&network});
+
+    fge::net::ClientList clients;
+    clients.watchEvent(true);
+
+    fge::Scene clientScene;
+
+    //Create and authenticate the synthetic clients
+    std::vector<SyntheticClient> syntheticClients;
+    syntheticClients.reserve(playerCount);
+    for (std::size_t i = 0; i < playerCount; ++i)
+    {
+        auto& syntheticClient = syntheticClients.emplace_back();
+        syntheticClient._identity = {fge::net::IpAddress{"10.0.0.1"}, static_cast<fge::net::Port>(10000 + i)};
+        syntheticClient._client = std::make_shared<fge::net::Client>();
+        syntheticClient._position = {fge::_random.range(0.0f, 512.0f), fge::_random.range(0.0f, 512.0f)};
+
+        clients.add(syntheticClient._identity, syntheticClient._client);
+
+        fge::net::Packet helloPacket;
+        helloPacket << std::string{F_NET_CLIENT_HELLO} << syntheticClient._position << std::string{};
+        scene->onClientAskConnect(syntheticClient._client, syntheticClient._identity, helloPacket, 0);
+
+        if (syntheticClient._client->getStatus().getNetworkStatus() !=
+            fge::net::ClientStatus::NetworkStatus::AUTHENTICATED)
+        {
+            std::cout << "Can't authenticate the synthetic client " << i << "\n";
+            return;
+        }
+        PopPendingPackets(syntheticClient);
+    }
+
+    //Warm up, the first ticks are sending the new objects to everyone
+    for (std::size_t i = 0; i < 5; ++i)
+    {
+        RunTick(*scene, clients, syntheticClients, clientScene);
+    }
+
+    TickResult total;
+    for (std::size_t i = 0; i < tickCount; ++i)
+    {
+        auto const result = RunTick(*scene, clients, syntheticClients, clientScene);
+        total._simulation += result._simulation;
+        total._send += result._send;
+        total._bytes += result._bytes;
+        total._allocations += result._allocations;
+    }
+
+    auto const simulationNs = total._simulation.count() / static_cast<long long>(tickCount);
+    auto const sendNs = total._send.count() / static_cast<long long>(tickCount);
+
+    std::cout << std::setw(8) << playerCount << std::setw(16) << simulationNs << std::setw(16) << sendNs
+              << std::setw(16) << simulationNs + sendNs << std::setw(16)
+              << total._bytes / (tickCount * playerCount) << std::setw(16) << total._allocations / tickCount
+              << "\n";
+
+    scene->getSendPipeline().stop();
+    scene.reset();
+}
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    ++gAllocationCount;
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+void operator delete(void* ptr, [[maybe_unused]] std::size_t size) noexcept
+{
+    std::free(ptr);
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t tickCount = 100;
+    if (argc > 1)
+    {
+        tickCount = std::max<std::size_t>(1, std::strtoull(argv[1], nullptr, 10));
+    }
+
+    if (!fge::net::Socket::initSocket())
+    {
+        return -1;
+    }
+
+    fge::texture::gManager.initialize();
+    fge::anim::gManager.initialize();
+    fge::reg::RegisterNewClass(std::make_unique<fge::reg::Stamp<Player>>());
+
+    std::cout << "Server tick benchmark, " << tickCount << " ticks per run\n";
+    std::cout << std::setw(8) << "players" << std::setw(16) << "sim ns/tick" << std::setw(16) << "send ns/tick"
+              << std::setw(16) << "total ns/tick" << std::setw(16) << "bytes/client" << std::setw(16)
+              << "allocs/tick" << "\n";
+
+    for (std::size_t const playerCount: {10, 100, 1000, 5000})
+    {
+        RunBenchmark(playerCount, tickCount);
+    }
+
+    fge::anim::gManager.uninitialize();
+    fge::texture::gManager.uninitialize();
+
+    SDL_Quit();
+
+    return 0;
+}
@@ -0,0 +1,240 @@
+#include "assetLoader.hpp"
+#include "FastEngine/manager/anim_manager.hpp"
+#include "FastEngine/manager/audio_manager.hpp"
+#include "FastEngine/manager/texture_manager.hpp"
+#include "FastEngine/vulkan/vulkanGlobal.hpp"
+#include <algorithm>
+#include <iostream>
+
+AssetLoader::~AssetLoader()
+{
+    this->stop();
+}
+
+void AssetLoader::pushTexture(std::string name, std::filesystem::path path, Groups group, Callback onLoaded)
+{
+    this->push({Types::TEXTURE, group, std::move(name), std::move(path), std::move(onLoaded)});
+}
+void AssetLoader::pushAudio(std::string name, std::filesystem::path path, Groups group, Callback onLoaded)
+{
+    this->push({Types::AUDIO, group, std::move(name), std::move(path), std::move(onLoaded)});
+}
+void AssetLoader::pushAtlas(TextureAtlas& atlas,
+                            std::vector<TextureAtlas::Sprite> sprites,
+                            Groups group,
+                            Callback onLoaded)
+{
+    Job job{Types::ATLAS, group, atlas.getName(), {}, std::move(onLoaded)};
+    job._atlas = &atlas;
+    job._sprites = std::move(sprites);
+    this->push(std::move(job));
+}
+
+void AssetLoader::start()
+{
+    std::scoped_lock const lock(this->g_mutex);
+    if (this->g_running)
+    {
+        return;
+    }
+    this->g_running = true;
+
+    auto const threadCount = std::clamp(std::thread::hardware_concurrency(), 2u, F_ASSET_LOADER_MAX_THREADS + 1u) - 1;
+    for (unsigned int i = 0; i < threadCount; ++i)
+    {
+        this->g_threads.emplace_back(&AssetLoader::work, this);
+    }
+}
+void AssetLoader::stop()
+{
+    {
+        std::scoped_lock const lock(this->g_mutex);
+        this->g_running = false;
+    }
+    this->g_cv.notify_all();
+
+    for (auto& thread: this->g_threads)
+    {
+        thread.join();
+    }
+    this->g_threads.clear();
+
+    for (auto& jobs: this->g_pendingJobs)
+    {
+        jobs.clear();
+    }
+    this->g_decodedJobs.clear();
+    this->g_totalCount.fill(0);
+    this->g_uploadedCount.fill(0);
+}
+
+std::size_t AssetLoader::processUploads(std::size_t maxCount)
+{
+    std::vector<Job> jobs;
+    {
+        std::scoped_lock const lock(this->g_mutex);
+        while (!this->g_decodedJobs.empty() && jobs.size() < maxCount)
+        {
+            jobs.push_back(std::move(this->g_decodedJobs.front()));
+            this->g_decodedJobs.pop_front();
+        }
+    }
+
+    for (auto& job: jobs)
+    {
+        AssetLoader::upload(job);
+        if (job._onLoaded)
+        {
+            job._onLoaded();
+        }
+    }
+
+    if (!jobs.empty())
+    {
+        std::scoped_lock const lock(this->g_mutex);
+        for (auto const& job: jobs)
+        {
+            ++this->g_uploadedCount[static_cast<std::size_t>(job._group)];
+        }
+    }
+    return jobs.size();
+}
+
+float AssetLoader::getProgress(Groups group) const
+{
+    std::scoped_lock const lock(this->g_mutex);
+    auto const index = static_cast<std::size_t>(group);
+    if (this->g_totalCount[index] == 0)
+    {
+        return 1.0f;
+    }
+    return static_cast<float>(this->g_uploadedCount[index]) / static_cast<float>(this->g_totalCount[index]);
+}
+bool AssetLoader::isDone(Groups group) const
+{
+    std::scoped_lock const lock(this->g_mutex);
+    auto const index = static_cast<std::size_t>(group);
+    return this->g_uploadedCount[index] == this->g_totalCount[index];
+}
+
+void AssetLoader::push(Job&& job)
+{
+    {
+        std::scoped_lock const lock(this->g_mutex);
+        auto const index = static_cast<std::size_t>(job._group);
+        ++this->g_totalCount[index];
+        this->g_pendingJobs[index].push_back(std::move(job));
+    }
+    this->g_cv.notify_one();
+}
+
+void AssetLoader::work()
+{
+    std::unique_lock lock(this->g_mutex);
+    while (true)
+    {
+        this->g_cv.wait(lock, [&]() {
+            return !this->g_running ||
+                   std::ranges::any_of(this->g_pendingJobs, [](auto const& pending) { return !pending.empty(); });
+        });
+        if (!this->g_running)
+        {
+            break;
+        }
+
+        //STARTUP jobs first
+        auto& jobs = *std::ranges::find_if(this->g_pendingJobs, [](auto const& pending) { return !pending.empty(); });
+        Job job = std::move(jobs.front());
+        jobs.pop_front();
+
+        lock.unlock();
+        AssetLoader::decode(job);
+        lock.lock();
+
+        this->g_decodedJobs.push_back(std::move(job));
+    }
+}
+
+void AssetLoader::decode(Job& job)
+{
+    switch (job._type)
+    {
+    case Types::TEXTURE:
+        job._surface = std::make_unique<fge::Surface>();
+        if (!job._surface->loadFromFile(job._path))
+        {
+            std::cout << "Can't load texture " << job._path << "\n";
+            job._surface.reset();
+        }
+        break;
+    case Types::AUDIO:
+        if (auto* chunk = Mix_LoadWAV(job._path.string().c_str()))
+        {
+            job._chunk = std::shared_ptr<Mix_Chunk>(chunk, Mix_FreeChunk);
+        }
+        else
+        {
+            std::cout << "Can't load audio " << job._path << "\n";
+        }
+        break;
+    case Types::ATLAS:
+        if (job._atlas->build(job._sprites))
+        {
+            job._surface = job._atlas->releaseSurface();
+        }
+        break;
+    }
+}
+void AssetLoader::upload(Job& job)
+{
+    switch (job._type)
+    {
+    case Types::TEXTURE:
+    case Types::ATLAS:
+        if (job._surface)
+        {
+            AssetLoader::uploadTexture(job._name, *job._surface);
+            job._surface.reset();
+        }
+        break;
+    case Types::AUDIO:
+    {
+        if (!job._chunk)
+        {
+            return;
+        }
+
+        auto block = std::make_shared<fge::audio::AudioManager::DataBlockType>();
+        block->_ptr = std::move(job._chunk);
+        block->_valid = true;
+        fge::audio::gManager.push(job._name, std::move(block));
+    }
+    break;
+    }
+}
+
+void AssetLoader::uploadTexture(std::string const& name, fge::Surface& surface)
+{
+    auto block = std::make_shared<fge::texture::TextureManager::DataBlockType>();
+    block->_ptr = std::make_shared<fge::TextureType>(fge::vulkan::GetActiveContext());
+    block->_ptr->create(surface.get());
+    block->_valid = true;
+    fge::texture::gManager.push(name, std::move(block));
+}
+bool AssetLoader::ShareAnimationTexture(std::string const& name)
+{
+    auto const animation = fge::anim::gManager.getElement(name);
+    if (!animation->_valid || !animation->_ptr->_tilesetTexture)
+    {
+        std::cout << "AssetLoader: the animation \"" << name << "\" has no tileset texture\n";
+        return false;
+    }
+
+    auto block = std::make_shared<fge::texture::TextureManager::DataBlockType>();
+    block->_ptr = animation->_ptr->_tilesetTexture;
+    block->_valid = true;
+    fge::texture::gManager.push(name, std::move(block));
+    return true;
+}
+
+AssetLoader gAssetLoader;
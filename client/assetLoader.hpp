@@ -0,0 +1,100 @@
+#pragma once
+
+#include "FastEngine/C_surface.hpp"
+#include "SDL_mixer.h"
+#include "textureAtlas.hpp"
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define F_ASSET_LOADER_MAX_THREADS 4
+#define F_ASSET_LOADER_UPLOAD_BATCH 8
+
+/*
+ * Job based asset loader.
+ *
+ * Files are decoded (PNG into surfaces, OGG into audio chunks) by worker threads, the main thread then uploads
+ * the decoded assets into the managers in small batches with processUploads().
+ * STARTUP assets are always decoded first, DEFERRED assets are loaded while the game is already running.
+ * An atlas job decodes and packs all its sprites on the same worker and is uploaded as one texture.
+ */
+class AssetLoader
+{
+public:
+    enum class Groups : uint8_t
+    {
+        STARTUP,
+        DEFERRED,
+
+        GROUP_COUNT
+    };
+    using Callback = std::function<void()>;
+
+    AssetLoader() = default;
+    ~AssetLoader();
+
+    void pushTexture(std::string name, std::filesystem::path path, Groups group, Callback onLoaded = {});
+    void pushAudio(std::string name, std::filesystem::path path, Groups group, Callback onLoaded = {});
+    void pushAtlas(TextureAtlas& atlas,
+                   std::vector<TextureAtlas::Sprite> sprites,
+                   Groups group,
+                   Callback onLoaded = {});
+
+    //Register the tileset of a loaded animation as a texture with the same name, the file is not loaded again
+    static bool ShareAnimationTexture(std::string const& name);
+
+    void start();
+    void stop();
+
+    //Must be called from the main thread, return the number of uploaded assets
+    std::size_t processUploads(std::size_t maxCount = F_ASSET_LOADER_UPLOAD_BATCH);
+
+    [[nodiscard]] float getProgress(Groups group) const;
+    [[nodiscard]] bool isDone(Groups group) const;
+
+private:
+    enum class Types : uint8_t
+    {
+        TEXTURE,
+        AUDIO,
+        ATLAS
+    };
+    struct Job
+    {
+        Types _type;
+        Groups _group;
+        std::string _name;
+        std::filesystem::path _path;
+        Callback _onLoaded;
+
+        std::unique_ptr<fge::Surface> _surface;
+        std::shared_ptr<Mix_Chunk> _chunk;
+        TextureAtlas* _atlas = nullptr;
+        std::vector<TextureAtlas::Sprite> _sprites;
+    };
+
+    void push(Job&& job);
+    void work();
+    static void decode(Job& job);
+    static void upload(Job& job);
+    static void uploadTexture(std::string const& name, fge::Surface& surface);
+
+    std::array<std::deque<Job>, static_cast<std::size_t>(Groups::GROUP_COUNT)> g_pendingJobs;
+    std::deque<Job> g_decodedJobs;
+    std::array<std::size_t, static_cast<std::size_t>(Groups::GROUP_COUNT)> g_totalCount{};
+    std::array<std::size_t, static_cast<std::size_t>(Groups::GROUP_COUNT)> g_uploadedCount{};
+
+    bool g_running = false;
+    mutable std::mutex g_mutex;
+    std::condition_variable g_cv;
+    std::vector<std::thread> g_threads;
+};
+
+extern AssetLoader gAssetLoader;
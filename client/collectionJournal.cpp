@@ -0,0 +1,239 @@
+#include "collectionJournal.hpp"
+#include "FastEngine/extra/extra_function.hpp"
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+
+//The files can be edited or damaged, a record is checked before FishInstance reads it
+bool IsFishRecord(nlohmann::json const& record)
+{
+    if (!record.is_object())
+    {
+        return false;
+    }
+
+    auto const name = record.find("name");
+    auto const weight = record.find("weight");
+    auto const length = record.find("length");
+    auto const starCount = record.find("starCount");
+    return name != record.end() && name->is_string() && weight != record.end() && weight->is_number() &&
+           length != record.end() && length->is_number() && starCount != record.end() &&
+           starCount->is_number_unsigned() && starCount->get<uint64_t>() <= UINT8_MAX;
+}
+
+} // namespace
+
+//CollectionJournal
+
+CollectionJournal::~CollectionJournal()
+{
+    this->stop();
+}
+
+bool CollectionJournal::load(std::filesystem::path const& snapshotPath,
+                             std::filesystem::path const& journalPath,
+                             Collection& collection)
+{
+    this->g_snapshotPath = snapshotPath;
+    this->g_journalPath = journalPath;
+    this->g_collection.clear();
+    this->g_journalRecordCount = 0;
+    this->g_journalDamaged = false;
+
+    bool valid = true;
+
+    nlohmann::json jsonFish;
+    if (fge::LoadJsonFromFile(snapshotPath, jsonFish))
+    {
+        for (auto const& [name, instance]: jsonFish.items())
+        {
+            if (!IsFishRecord(instance))
+            {
+                valid = false;
+                continue;
+            }
+
+            auto const fishInstance = instance.get<FishInstance>();
+            this->g_collection[name] = fishInstance;
+            if (name != fishInstance._name)
+            {
+                valid = false;
+            }
+        }
+    }
+    else
+    {
+        valid = false;
+    }
+
+    //The records are more recent than the snapshot
+    std::ifstream journalFile(journalPath, std::ios::binary);
+    std::string line;
+    std::uintmax_t completeSize = 0;
+    bool damaged = false;
+    while (std::getline(journalFile, line))
+    {
+        //A record without its line feed would be merged with the next appended one
+        bool const complete = !journalFile.eof();
+
+        if (!line.empty())
+        {
+            auto const record = nlohmann::json::parse(line, nullptr, false);
+            if (record.is_discarded() || !IsFishRecord(record))
+            { //Incomplete last record (crash while writing)
+                damaged = true;
+                break;
+            }
+
+            auto fishInstance = record.get<FishInstance>();
+            auto const name = fishInstance._name;
+            this->g_collection[name] = std::move(fishInstance);
+            ++this->g_journalRecordCount;
+        }
+
+        if (!complete)
+        {
+            damaged = true;
+            break;
+        }
+        completeSize += line.size() + 1;
+    }
+    journalFile.close();
+
+    if (damaged)
+    {
+        //The next records must be appended after the last complete one
+        std::cout << "Ignoring an incomplete record of " << journalPath << '\n';
+        std::error_code err;
+        std::filesystem::resize_file(journalPath, completeSize, err);
+        if (err)
+        {
+            std::cout << "Can't truncate " << journalPath << ": " << err.message() << '\n';
+            this->g_journalDamaged = true;
+        }
+    }
+
+    collection = this->g_collection;
+    return valid || this->g_journalRecordCount != 0;
+}
+void CollectionJournal::start()
+{
+    std::scoped_lock const lock(this->g_mutex);
+    if (this->g_running)
+    {
+        return;
+    }
+
+    this->g_running = true;
+    this->g_thread = std::thread(&CollectionJournal::work, this);
+}
+void CollectionJournal::stop()
+{
+    {
+        std::scoped_lock const lock(this->g_mutex);
+        if (!this->g_running)
+        {
+            return;
+        }
+        this->g_running = false;
+    }
+    this->g_cv.notify_all();
+
+    if (this->g_thread.joinable())
+    {
+        this->g_thread.join();
+    }
+}
+
+void CollectionJournal::push(FishInstance const& fish)
+{
+    {
+        std::scoped_lock const lock(this->g_mutex);
+        this->g_pendingRecords.push_back(fish);
+    }
+    this->g_cv.notify_one();
+}
+
+void CollectionJournal::work()
+{
+    if (this->g_journalRecordCount != 0 || this->g_journalDamaged)
+    {
+        this->compact();
+    }
+
+    std::vector<FishInstance> records;
+    bool running = true;
+    while (running)
+    {
+        {
+            std::unique_lock lock(this->g_mutex);
+            this->g_cv.wait(lock, [this]() { return !this->g_running || !this->g_pendingRecords.empty(); });
+            running = this->g_running;
+            records.swap(this->g_pendingRecords);
+        }
+
+        if (!records.empty())
+        {
+            this->appendRecords(records);
+            records.clear();
+        }
+
+        if (this->g_journalRecordCount >= F_COLLECTION_JOURNAL_COMPACT_COUNT ||
+            (!running && this->g_journalRecordCount != 0))
+        {
+            this->compact();
+        }
+    }
+}
+void CollectionJournal::appendRecords(std::vector<FishInstance> const& records)
+{
+    std::string buffer;
+    for (auto const& record: records)
+    {
+        this->g_collection[record._name] = record;
+        buffer += nlohmann::json(record).dump();
+        buffer += '\n';
+    }
+
+    std::ofstream journalFile(this->g_journalPath, std::ios::binary | std::ios::app);
+    journalFile.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    journalFile.flush();
+    if (!journalFile)
+    {
+        std::cout << "Can't write " << this->g_journalPath << ", the records are kept for the next snapshot\n";
+    }
+    this->g_journalRecordCount += records.size();
+}
+void CollectionJournal::compact()
+{
+    nlohmann::json jsonFish;
+    for (auto const& [name, instance]: this->g_collection)
+    {
+        jsonFish[name] = instance;
+    }
+
+    //The snapshot is replaced at once, it is never half written
+    auto tmpPath = this->g_snapshotPath;
+    tmpPath += ".tmp";
+    if (!fge::SaveJsonToFile(tmpPath, jsonFish))
+    {
+        std::cout << "Can't save " << tmpPath << ", the journal is kept\n";
+        return;
+    }
+
+    std::error_code err;
+    std::filesystem::rename(tmpPath, this->g_snapshotPath, err);
+    if (err)
+    {
+        std::cout << "Can't replace " << this->g_snapshotPath << ": " << err.message() << ", the journal is kept\n";
+        return;
+    }
+
+    //Every record is now in the snapshot
+    std::ofstream journalFile(this->g_journalPath, std::ios::binary | std::ios::trunc);
+    this->g_journalRecordCount = 0;
+    this->g_journalDamaged = false;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "fish.hpp"
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#define F_COLLECTION_JOURNAL_FILE "fish_collection.journal"
+#define F_COLLECTION_JOURNAL_COMPACT_COUNT 32 // Records appended before the journal is merged into the snapshot
+
+/*
+ * Write-behind persistence of the fish collection.
+ *
+ * The collection is stored as a json snapshot plus a journal of records, one json line per modified fish (the
+ * whole fish entry, so the replay is a simple overwrite). Records are pushed by the main thread without blocking
+ * and appended to the journal by a worker thread.
+ *
+ * Every F_COLLECTION_JOURNAL_COMPACT_COUNT records (and when stopping) the worker writes a new snapshot in a
+ * temporary file, renames it over the old one then empties the journal. A crash can then only lose the last
+ * journal line, an incomplete line is ignored at the next load and cut from the journal.
+ */
+class CollectionJournal
+{
+public:
+    using Collection = std::unordered_map<std::string, FishInstance>;
+
+    CollectionJournal() = default;
+    ~CollectionJournal();
+
+    //Load the snapshot and replay the journal, return false if the snapshot can't be loaded or is invalid
+    bool load(std::filesystem::path const& snapshotPath,
+              std::filesystem::path const& journalPath,
+              Collection& collection);
+    //Start the worker with the loaded collection, a non-empty journal is compacted right away
+    void start();
+    //Write the pending records and compact the journal
+    void stop();
+
+    void push(FishInstance const& fish);
+
+private:
+    void work();
+    void appendRecords(std::vector<FishInstance> const& records);
+    void compact();
+
+    std::filesystem::path g_snapshotPath;
+    std::filesystem::path g_journalPath;
+
+    //Only accessed by the worker once started
+    Collection g_collection;
+    std::size_t g_journalRecordCount = 0;
+    bool g_journalDamaged = false; //The journal could not be truncated after its last complete record
+
+    std::vector<FishInstance> g_pendingRecords;
+
+    bool g_running = false;
+    std::mutex g_mutex;
+    std::condition_variable g_cv;
+    std::thread g_thread;
+};
@@ -0,0 +1,159 @@
+#include "colliderBuilder.hpp"
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+namespace
+{
+
+bool IsNear(float a, float b)
+{
+    return std::abs(a - b) <= F_COLLIDER_MERGE_EPSILON;
+}
+bool Contains(fge::RectFloat const& outer, fge::RectFloat const& inner)
+{
+    return inner._x >= outer._x - F_COLLIDER_MERGE_EPSILON && inner._y >= outer._y - F_COLLIDER_MERGE_EPSILON &&
+           inner._x + inner._width <= outer._x + outer._width + F_COLLIDER_MERGE_EPSILON &&
+           inner._y + inner._height <= outer._y + outer._height + F_COLLIDER_MERGE_EPSILON;
+}
+
+//Remove every rect that is inside another one
+bool RemoveContainedRects(std::vector<fge::RectFloat>& rects)
+{
+    bool changed = false;
+    for (std::size_t i = 0; i < rects.size(); ++i)
+    {
+        for (std::size_t j = 0; j < rects.size(); ++j)
+        {
+            if (i != j && Contains(rects[j], rects[i]))
+            {
+                rects[i] = rects.back();
+                rects.pop_back();
+                --i;
+                changed = true;
+                break;
+            }
+        }
+    }
+    return changed;
+}
+
+//Join the rects of the same row (same y and height) that touch or overlap
+bool MergeRows(std::vector<fge::RectFloat>& rects)
+{
+    std::ranges::sort(rects, {}, [](fge::RectFloat const& rect) {
+        return std::tie(rect._y, rect._height, rect._x);
+    });
+
+    bool changed = false;
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < rects.size(); ++i)
+    {
+        if (count != 0)
+        {
+            auto& last = rects[count - 1];
+            if (IsNear(last._y, rects[i]._y) && IsNear(last._height, rects[i]._height) &&
+                rects[i]._x <= last._x + last._width + F_COLLIDER_MERGE_EPSILON)
+            {
+                last._width = std::max(last._x + last._width, rects[i]._x + rects[i]._width) - last._x;
+                changed = true;
+                continue;
+            }
+        }
+        rects[count++] = rects[i];
+    }
+    rects.resize(count);
+    return changed;
+}
+
+//Join the rects of the same column (same x and width) that touch or overlap
+bool MergeColumns(std::vector<fge::RectFloat>& rects)
+{
+    std::ranges::sort(rects, {}, [](fge::RectFloat const& rect) {
+        return std::tie(rect._x, rect._width, rect._y);
+    });
+
+    bool changed = false;
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < rects.size(); ++i)
+    {
+        if (count != 0)
+        {
+            auto& last = rects[count - 1];
+            if (IsNear(last._x, rects[i]._x) && IsNear(last._width, rects[i]._width) &&
+                rects[i]._y <= last._y + last._height + F_COLLIDER_MERGE_EPSILON)
+            {
+                last._height = std::max(last._y + last._height, rects[i]._y + rects[i]._height) - last._y;
+                changed = true;
+                continue;
+            }
+        }
+        rects[count++] = rects[i];
+    }
+    rects.resize(count);
+    return changed;
+}
+
+} // namespace
+
+void ColliderBuilder::push(fge::RectFloat const& rect)
+{
+    if (rect._width <= 0.0f || rect._height <= 0.0f)
+    {
+        return;
+    }
+    this->g_rects.push_back(rect);
+}
+void ColliderBuilder::clear()
+{
+    this->g_rects.clear();
+}
+
+void ColliderBuilder::merge()
+{
+    MergeRects(this->g_rects);
+}
+std::vector<fge::RectFloat> const& ColliderBuilder::getRects() const
+{
+    return this->g_rects;
+}
+
+b2BodyId ColliderBuilder::build(b2WorldId world)
+{
+    b2BodyDef bodyDef = b2DefaultBodyDef();
+    bodyDef.type = b2_staticBody;
+
+    b2BodyId bodyId = b2CreateBody(world, &bodyDef);
+
+    b2ShapeDef shapeDef = b2DefaultShapeDef();
+    for (auto const& rect: this->g_rects)
+    {
+        //The body is at the origin, so the box points are directly in world space
+        b2Vec2 const points[4] = {{rect._x, rect._y},
+                                  {rect._x + rect._width, rect._y},
+                                  {rect._x + rect._width, rect._y + rect._height},
+                                  {rect._x, rect._y + rect._height}};
+        b2Hull const hull = b2ComputeHull(points, 4);
+        if (hull.count == 0)
+        {
+            continue;
+        }
+
+        b2Polygon const box = b2MakePolygon(&hull, 0.0f);
+        b2CreatePolygonShape(bodyId, &shapeDef, &box);
+    }
+
+    this->g_rects.clear();
+    return bodyId;
+}
+
+void ColliderBuilder::MergeRects(std::vector<fge::RectFloat>& rects)
+{
+    bool changed = true;
+    while (changed)
+    {
+        changed = RemoveContainedRects(rects);
+        changed |= MergeRows(rects);
+        changed |= MergeColumns(rects);
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "FastEngine/C_rect.hpp"
+#include "box2d/box2d.h"
+#include <vector>
+
+#define F_COLLIDER_MERGE_EPSILON 0.01f
+
+/*
+ * Static collider builder.
+ *
+ * Collision rects are merged greedily into bigger rects (rects on the same row are joined when they touch or
+ * overlap, then the same is done on columns, until nothing changes) and every remaining rect is attached as a box
+ * shape to a single static body. This keeps the body and shape count low in the broadphase.
+ */
+class ColliderBuilder
+{
+public:
+    ColliderBuilder() = default;
+
+    void push(fge::RectFloat const& rect);
+    void clear();
+
+    void merge();
+    [[nodiscard]] std::vector<fge::RectFloat> const& getRects() const;
+
+    //Create the static body with every rect (call merge() before), the builder is cleared after
+    b2BodyId build(b2WorldId world);
+
+    static void MergeRects(std::vector<fge::RectFloat>& rects);
+
+private:
+    std::vector<fge::RectFloat> g_rects;
+};
@@ -0,0 +1,176 @@
+#include "depthSorter.hpp"
+#include "entityBatch.hpp"
+#include <algorithm>
+#include <limits>
+
+void DepthSorter::setDepthPlan(fge::ObjectPlan plan)
+{
+    this->g_depthPlan = plan;
+    this->g_order.clear();
+}
+void DepthSorter::setDepthLines(std::span<float const> depthLines)
+{
+    this->g_depthLines = depthLines;
+    this->g_order.clear();
+}
+
+void DepthSorter::setBatches(fge::ObjectDataShared const& behindBatch, fge::ObjectDataShared const& frontBatch)
+{
+    this->g_behindBatch = behindBatch;
+    this->g_frontBatch = frontBatch;
+    this->g_order.clear();
+}
+
+void DepthSorter::add(fge::ObjectDataShared const& object, float anchorOffset, SubmitFunction submit)
+{
+    this->g_actors.push_back({object, anchorOffset, std::move(submit)});
+    this->g_order.clear();
+}
+void DepthSorter::addGroup(fge::ObjectDataShared const& object,
+                           GroupCountFunction count,
+                           GroupAnchorFunction anchor,
+                           GroupSubmitFunction submit)
+{
+    this->g_groups.push_back({object, std::move(count), std::move(anchor), std::move(submit)});
+}
+void DepthSorter::clear()
+{
+    this->g_behindBatch.reset();
+    this->g_frontBatch.reset();
+    this->g_actors.clear();
+    this->g_groups.clear();
+    this->g_sortedEntries.clear();
+    this->g_order.clear();
+}
+
+void DepthSorter::update(fge::Scene& scene)
+{
+    //Remove the actors that are gone and retrieve the positions
+    std::erase_if(this->g_actors, [](Actor const& actor) { return actor._object.expired(); });
+    std::erase_if(this->g_groups, [](Group const& group) { return group._object.expired(); });
+
+    auto const behindBatch = this->g_behindBatch.lock();
+    auto const frontBatch = this->g_frontBatch.lock();
+    bool const batching = behindBatch && frontBatch;
+
+    this->g_sortedEntries.clear();
+    for (auto const& actor: this->g_actors)
+    {
+        auto const object = actor._object.lock();
+        if (object->getPlan() != this->g_depthPlan && !(batching && actor._submit))
+        {
+            scene.setObjectPlan(object->getSid(), this->g_depthPlan);
+            this->g_order.clear();
+        }
+
+        this->g_sortedEntries.push_back(
+                {object->getObject()->getPosition().y + actor._anchorOffset, true, &actor, nullptr, 0});
+    }
+    if (batching)
+    {
+        for (auto const& group: this->g_groups)
+        {
+            auto const count = group._count();
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                this->g_sortedEntries.push_back({group._anchor(i), true, nullptr, &group, i});
+            }
+        }
+    }
+
+    std::ranges::sort(this->g_sortedEntries, {}, &Entry::_y);
+
+    //Actors and depth lines are both sorted, so the closest lines are found by walking them together
+    auto lineIt = this->g_depthLines.begin();
+    for (auto& entry: this->g_sortedEntries)
+    {
+        while (lineIt != this->g_depthLines.end() && *lineIt <= entry._y)
+        {
+            ++lineIt;
+        }
+
+        float distanceDown = std::numeric_limits<float>::max();
+        float distanceUp = std::numeric_limits<float>::max();
+        if (lineIt != this->g_depthLines.end())
+        {
+            distanceDown = *lineIt - entry._y;
+        }
+        if (lineIt != this->g_depthLines.begin())
+        {
+            distanceUp = entry._y - *std::prev(lineIt) - F_DEPTH_LINE_UP_OFFSET;
+        }
+
+        entry._front = !(distanceUp < distanceDown);
+    }
+
+    this->g_newOrder.clear();
+    if (batching)
+    {
+        auto& behind = *static_cast<EntityBatch*>(behindBatch->getObject());
+        auto& front = *static_cast<EntityBatch*>(frontBatch->getObject());
+        behind.begin();
+        front.begin();
+
+        for (auto const& entry: this->g_sortedEntries)
+        {
+            auto& batch = entry._front ? front : behind;
+            if (entry._group != nullptr)
+            {
+                entry._group->_submit(batch, entry._index);
+            }
+            else if (entry._actor->_submit)
+            {
+                entry._actor->_submit(batch);
+            }
+        }
+
+        behind.end();
+        front.end();
+
+        for (auto const& batch: {behindBatch, frontBatch})
+        {
+            if (batch->getPlan() != this->g_depthPlan)
+            {
+                scene.setObjectPlan(batch->getSid(), this->g_depthPlan);
+                this->g_order.clear();
+            }
+        }
+
+        //The behind batch is the last pushed to the bottom and the front batch the last pushed to the top
+        this->g_newOrder.emplace_back(behindBatch->getSid(), false);
+    }
+    for (auto const& entry: this->g_sortedEntries)
+    {
+        if (entry._actor != nullptr && !(batching && entry._actor->_submit))
+        {
+            this->g_newOrder.emplace_back(entry._actor->_object.lock()->getSid(), entry._front);
+        }
+    }
+    if (batching)
+    {
+        this->g_newOrder.emplace_back(frontBatch->getSid(), true);
+    }
+
+    if (this->g_newOrder == this->g_order)
+    {
+        return;
+    }
+    std::swap(this->g_order, this->g_newOrder);
+
+    //Front actors are pushed to the top of the plan from the farthest to the nearest,
+    //behind actors are pushed to the bottom of the plan from the nearest to the farthest
+    for (auto const& [sid, front]: this->g_order)
+    {
+        if (front)
+        {
+            scene.setObjectPlanTop(sid);
+        }
+    }
+    for (auto it = this->g_order.rbegin(); it != this->g_order.rend(); ++it)
+    {
+        if (!it->second)
+        {
+            scene.setObjectPlanBot(it->first);
+        }
+    }
+}
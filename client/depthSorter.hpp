@@ -0,0 +1,90 @@
+#pragma once
+
+#include "FastEngine/C_scene.hpp"
+#include <functional>
+#include <span>
+#include <vector>
+
+//Mitigate the effect when 2 depth objects are very close
+#define F_DEPTH_LINE_UP_OFFSET 4.0f
+
+class EntityBatch;
+
+/*
+ * Y-sorted depth system for the dynamic actors.
+ *
+ * Once per frame, every registered actor is sorted by its y (anchor) and walked together with the sorted depth
+ * lines of the map, an actor closer to the depth line above it than the one below it is behind the depth objects.
+ * All actors are then placed in the depth objects plan: behind actors at the bottom of the plan and front actors
+ * at the top of the plan, both in y order. The scene is only touched when the order changes.
+ *
+ * Actors registered with a submit function are not moved in the scene, they submit their sprites in y order to the
+ * behind or the front entity batch instead. The behind batch is kept at the bottom of the plan and the front batch
+ * at the top of the plan.
+ *
+ * A group is one object holding many actors (e.g. the duck flock), every element of the group has its own anchor
+ * and is sorted with the other actors, the group always submits its sprites to the entity batches.
+ */
+class DepthSorter
+{
+public:
+    DepthSorter() = default;
+
+    void setDepthPlan(fge::ObjectPlan plan);
+    void setDepthLines(std::span<float const> depthLines);
+
+    using SubmitFunction = std::function<void(EntityBatch&)>;
+    using GroupCountFunction = std::function<std::size_t()>;
+    using GroupAnchorFunction = std::function<float(std::size_t index)>;
+    using GroupSubmitFunction = std::function<void(EntityBatch&, std::size_t index)>;
+
+    //Entity batches (EntityBatch objects) used by the actors with a submit function
+    void setBatches(fge::ObjectDataShared const& behindBatch, fge::ObjectDataShared const& frontBatch);
+
+    //The anchor offset is added to the actor y position (e.g. to use its feet)
+    void add(fge::ObjectDataShared const& object, float anchorOffset = 0.0f, SubmitFunction submit = {});
+    //The anchor function returns the y of an element, the group is removed with its object
+    void addGroup(fge::ObjectDataShared const& object,
+                  GroupCountFunction count,
+                  GroupAnchorFunction anchor,
+                  GroupSubmitFunction submit);
+    void clear();
+
+    void update(fge::Scene& scene);
+
+private:
+    struct Actor
+    {
+        fge::ObjectDataWeak _object;
+        float _anchorOffset;
+        SubmitFunction _submit;
+    };
+    struct Group
+    {
+        fge::ObjectDataWeak _object;
+        GroupCountFunction _count;
+        GroupAnchorFunction _anchor;
+        GroupSubmitFunction _submit;
+    };
+    //An actor or an element of a group
+    struct Entry
+    {
+        float _y;
+        bool _front;
+        Actor const* _actor;
+        Group const* _group;
+        std::size_t _index;
+    };
+
+    fge::ObjectPlan g_depthPlan{FGE_SCENE_PLAN_DEFAULT};
+    std::span<float const> g_depthLines;
+    fge::ObjectDataWeak g_behindBatch;
+    fge::ObjectDataWeak g_frontBatch;
+    std::vector<Actor> g_actors;
+    std::vector<Group> g_groups;
+    std::vector<Entry> g_sortedEntries;
+
+    //Order applied the last time, as (sid, front)
+    std::vector<std::pair<fge::ObjectSid, bool>> g_order;
+    std::vector<std::pair<fge::ObjectSid, bool>> g_newOrder;
+};
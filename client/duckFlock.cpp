@@ -0,0 +1,310 @@
+#include "duckFlock.hpp"
+#include "FastEngine/C_random.hpp"
+#include "FastEngine/manager/audio_manager.hpp"
+#include "FastEngine/object/C_objAnim.hpp"
+#include "entityBatch.hpp"
+#include "game.hpp"
+#include "mapCache.hpp"
+#include "navigation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+//DuckFlock
+
+FGE_OBJ_UPDATE_BODY(DuckFlock)
+{
+    auto const delta = fge::DurationToSecondFloat(deltaTime);
+    auto const count = this->g_positionsX.size();
+
+    if (count != 0)
+    {
+        this->g_timeBeforeQuack -= delta;
+        if (this->g_timeBeforeQuack <= 0.0f)
+        {
+            this->g_timeBeforeQuack = fge::_random.range(F_DUCK_QUACK_TIME_MIN_S, F_DUCK_QUACK_TIME_MAX_S);
+            Mix_PlayChannel(-1, fge::audio::gManager.getElement("ducky")->_ptr.get(), 0);
+        }
+    }
+
+    //Movement, idle ducks have a null speed and their target is their position
+    {
+        float* positionsX = this->g_positionsX.data();
+        float* positionsY = this->g_positionsY.data();
+        float const* targetsX = this->g_targetsX.data();
+        float const* targetsY = this->g_targetsY.data();
+        float const* walkSpeeds = this->g_walkSpeeds.data();
+        uint8_t* arrived = this->g_arrived.data();
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            float const dx = targetsX[i] - positionsX[i];
+            float const dy = targetsY[i] - positionsY[i];
+            float const distance = std::sqrt(dx * dx + dy * dy);
+            float const step = walkSpeeds[i] * delta;
+
+            bool const reached = distance <= step;
+            float const ratio = reached ? 1.0f : step / distance;
+
+            positionsX[i] += dx * ratio;
+            positionsY[i] += dy * ratio;
+            arrived[i] = reached && step > 0.0f ? 1 : 0;
+        }
+    }
+
+    //States and animations
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        switch (this->g_states[i])
+        {
+        case States::IDLE:
+        {
+            auto& pathRequest = this->g_pathRequests[i];
+
+            //Stay idle until the requested path arrives
+            if (pathRequest.isValid())
+            {
+                if (!pathRequest.isReady())
+                {
+                    break;
+                }
+
+                this->g_walkPaths[i] = pathRequest.takePath();
+                if (!this->g_walkPaths[i].empty())
+                {
+                    this->setState(i, States::WALKING);
+                }
+                break;
+            }
+
+            this->g_times[i] += delta;
+            if (this->g_times[i] >= this->g_timesBeforeWalk[i])
+            {
+                this->g_times[i] = 0.0f;
+                this->g_timesBeforeWalk[i] = fge::_random.range(F_DUCK_WALK_TIME_MIN_S, F_DUCK_WALK_TIME_MAX_S);
+
+                this->requestRandomWalkPath(i);
+            }
+            break;
+        }
+        case States::WALKING:
+        {
+            if (this->g_arrived[i] == 0)
+            {
+                break;
+            }
+
+            auto const cursor = ++this->g_walkPathCursors[i];
+            if (cursor >= this->g_walkPaths[i].size())
+            {
+                this->setState(i, States::IDLE);
+                break;
+            }
+
+            auto const& nextPosition = this->g_walkPaths[i][cursor];
+            this->g_flips[i] = this->g_positionsX[i] > nextPosition.x ? 1 : 0;
+            this->g_targetsX[i] = nextPosition.x;
+            this->g_targetsY[i] = nextPosition.y;
+            break;
+        }
+        }
+
+        auto const& frames = this->g_states[i] == States::WALKING ? this->g_walkFrames : this->g_idleFrames;
+        if (!frames.empty())
+        {
+            this->g_animationTimes[i] += delta;
+            while (this->g_animationTimes[i] >= frames[this->g_animationFrames[i]]._duration)
+            {
+                this->g_animationTimes[i] -= frames[this->g_animationFrames[i]]._duration;
+                this->g_animationFrames[i] = static_cast<uint8_t>((this->g_animationFrames[i] + 1) % frames.size());
+            }
+        }
+    }
+}
+FGE_OBJ_DRAW_BODY(DuckFlock)
+{
+    //Drawn by the depth sorter entity batches, see submitSprites()
+}
+
+void DuckFlock::first([[maybe_unused]] fge::Scene& scene)
+{
+    this->loadAnimationGroup("idle", this->g_idleFrames);
+    this->loadAnimationGroup("walk", this->g_walkFrames);
+
+    this->g_timeBeforeQuack = fge::_random.range(F_DUCK_QUACK_TIME_MIN_S, F_DUCK_QUACK_TIME_MAX_S);
+
+    //The feet of the ducks are used for the depth
+    if (!this->g_idleFrames.empty())
+    {
+        this->g_anchorOffset = static_cast<float>(this->g_idleFrames.front()._rect._height) / 2.0f * F_DUCK_FLOCK_SCALE;
+    }
+    gGameHandler->getDepthSorter().addGroup(
+            this->_myObjectData.lock(), [this]() { return this->getDuckCount(); },
+            [this](std::size_t index) { return this->g_positionsY[index] + this->g_anchorOffset; },
+            [this](EntityBatch& batch, std::size_t index) { this->submitSprites(batch, index); });
+}
+
+std::size_t DuckFlock::addDuck(fge::Vector2f const& position)
+{
+    auto const index = this->g_positionsX.size();
+
+    this->g_positionsX.push_back(position.x);
+    this->g_positionsY.push_back(position.y);
+    this->g_targetsX.push_back(position.x);
+    this->g_targetsY.push_back(position.y);
+    this->g_walkSpeeds.push_back(0.0f);
+    this->g_arrived.push_back(0);
+    this->g_states.push_back(States::IDLE);
+    this->g_flips.push_back(0);
+    this->g_times.push_back(0.0f);
+    this->g_timesBeforeWalk.push_back(fge::_random.range(F_DUCK_WALK_TIME_MIN_S, F_DUCK_WALK_TIME_MAX_S));
+    this->g_animationTimes.push_back(0.0f);
+    this->g_animationFrames.push_back(0);
+    this->g_walkPaths.emplace_back();
+    this->g_walkPathCursors.push_back(0);
+    this->g_pathRequests.emplace_back();
+
+    return index;
+}
+void DuckFlock::clearDucks()
+{
+    this->g_positionsX.clear();
+    this->g_positionsY.clear();
+    this->g_targetsX.clear();
+    this->g_targetsY.clear();
+    this->g_walkSpeeds.clear();
+    this->g_arrived.clear();
+    this->g_states.clear();
+    this->g_flips.clear();
+    this->g_times.clear();
+    this->g_timesBeforeWalk.clear();
+    this->g_animationTimes.clear();
+    this->g_animationFrames.clear();
+    this->g_walkPaths.clear();
+    this->g_walkPathCursors.clear();
+    this->g_pathRequests.clear();
+}
+std::size_t DuckFlock::getDuckCount() const
+{
+    return this->g_positionsX.size();
+}
+
+char const* DuckFlock::getClassName() const
+{
+    return "FISH_DUCK_FLOCK";
+}
+char const* DuckFlock::getReadableClassName() const
+{
+    return "duck flock";
+}
+
+fge::RectFloat DuckFlock::getGlobalBounds() const
+{
+    return this->getTransform() * this->getLocalBounds();
+}
+fge::RectFloat DuckFlock::getLocalBounds() const
+{
+    if (this->g_positionsX.empty() || this->g_idleFrames.empty())
+    {
+        return {};
+    }
+
+    auto const [minX, maxX] = std::ranges::minmax(this->g_positionsX);
+    auto const [minY, maxY] = std::ranges::minmax(this->g_positionsY);
+    auto const halfSize =
+            static_cast<fge::Vector2f>(this->g_idleFrames.front()._rect.getSize()) / 2.0f * F_DUCK_FLOCK_SCALE;
+    return {{minX - halfSize.x, minY - halfSize.y}, {maxX - minX + halfSize.x * 2.0f, maxY - minY + halfSize.y * 2.0f}};
+}
+
+void DuckFlock::loadAnimationGroup(char const* groupName, std::vector<Frame>& frames) const
+{
+    frames.clear();
+
+    fge::Animation animation{F_DUCK_FLOCK_ANIMATION, groupName};
+    auto const* group = animation.getGroup();
+    if (group == nullptr)
+    {
+        std::cout << "Can't load the duck animation group \"" << groupName << "\"\n";
+        return;
+    }
+
+    //Same tick duration as an ObjAnimation
+    auto const tickDuration = fge::DurationToSecondFloat(fge::ObjAnimation{}.getTickDuration());
+
+    frames.reserve(group->_frames.size());
+    for (std::size_t i = 0; i < group->_frames.size(); ++i)
+    {
+        animation.setFrame(i);
+        frames.push_back({animation.getTextureRect(), static_cast<float>(group->_frames[i]._ticks) * tickDuration});
+    }
+}
+void DuckFlock::setState(std::size_t index, States state)
+{
+    this->g_states[index] = state;
+    this->g_animationTimes[index] = 0.0f;
+    this->g_animationFrames[index] = 0;
+    this->g_walkPathCursors[index] = 0;
+
+    if (state == States::WALKING)
+    {
+        auto const& nextPosition = this->g_walkPaths[index].front();
+        this->g_walkSpeeds[index] = F_DUCK_SPEED;
+        this->g_flips[index] = this->g_positionsX[index] > nextPosition.x ? 1 : 0;
+        this->g_targetsX[index] = nextPosition.x;
+        this->g_targetsY[index] = nextPosition.y;
+    }
+    else
+    {
+        this->g_walkSpeeds[index] = 0.0f;
+        this->g_targetsX[index] = this->g_positionsX[index];
+        this->g_targetsY[index] = this->g_positionsY[index];
+        this->g_walkPaths[index].clear();
+    }
+}
+void DuckFlock::requestRandomWalkPath(std::size_t index)
+{
+    this->g_walkPaths[index].clear();
+    this->g_pathRequests[index].cancel();
+
+    if (!gNavigation.isBuilt())
+    {
+        return;
+    }
+
+    auto const duckPosition = gMapCache.getGridPosition({this->g_positionsX[index], this->g_positionsY[index]});
+    if (!duckPosition)
+    {
+        return;
+    }
+
+    //The destination is always in the same region, so a path exists
+    if (auto const destination = gNavigation.getRandomDestination(*duckPosition))
+    {
+        this->g_pathRequests[index] = gPathfindingService.request(*duckPosition, *destination);
+    }
+}
+void DuckFlock::submitSprites(EntityBatch& batch, std::size_t index) const
+{
+    if (this->g_idleFrames.empty() || this->g_walkFrames.empty())
+    {
+        return;
+    }
+
+    auto const& frames = this->g_states[index] == States::WALKING ? this->g_walkFrames : this->g_idleFrames;
+    auto const& rect = frames[this->g_animationFrames[index]]._rect;
+    float const flip = this->g_flips[index] != 0 ? -1.0f : 1.0f;
+    fge::Vector2f const position{this->g_positionsX[index], this->g_positionsY[index]};
+
+    //The shadow uses the same tileset with a black tint
+    fge::Transformable transform;
+    transform.setOrigin(static_cast<fge::Vector2f>(rect.getSize()) / 2.0f);
+    transform.setPosition({4.0f, 0.0f});
+    transform.setRotation(20.0f);
+    transform.setScale({0.8f * F_DUCK_FLOCK_SCALE * flip, 0.7f * F_DUCK_FLOCK_SCALE});
+    batch.submit(F_DUCK_FLOCK_ANIMATION, rect, transform, position, F_DUCK_FLOCK_SHADOW_COLOR);
+
+    transform.setPosition({0.0f, 0.0f});
+    transform.setRotation(0.0f);
+    transform.setScale({F_DUCK_FLOCK_SCALE * flip, F_DUCK_FLOCK_SCALE});
+    batch.submit(F_DUCK_FLOCK_ANIMATION, rect, transform, position, fge::Color::White);
+}
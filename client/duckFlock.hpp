@@ -0,0 +1,91 @@
+#pragma once
+
+#include "FastEngine/C_scene.hpp"
+#include "FastEngine/object/C_object.hpp"
+#include "pathfindingService.hpp"
+#include <cstdint>
+#include <vector>
+
+#define F_DUCK_SPEED 50.0f
+#define F_DUCK_WALK_TIME_MIN_S 3.0f
+#define F_DUCK_WALK_TIME_MAX_S 14.0f
+#define F_DUCK_QUACK_TIME_MIN_S 10.0f
+#define F_DUCK_QUACK_TIME_MAX_S 80.0f
+
+#define F_DUCK_FLOCK_ANIMATION "ducky_1"
+#define F_DUCK_FLOCK_SHADOW_COLOR fge::Color(0, 0, 0, 30)
+#define F_DUCK_FLOCK_SCALE 0.5f
+
+class EntityBatch;
+
+/*
+ * Every ambient duck of the map in one object.
+ *
+ * The duck states are stored as structure of arrays, the movement of all walking ducks is done in one branchless
+ * pass over the positions and targets, then a second pass handles the few ducks that reached a waypoint, that
+ * received their path or that want to walk again. Paths are read with a cursor, nothing is erased.
+ *
+ * The flock is a depth sorter group: every duck is sorted with the other actors by its feet and submits its shadow
+ * and its sprite to the entity batches, so the ducks are drawn in the same instanced runs as the players.
+ */
+class DuckFlock : public fge::Object
+{
+public:
+    DuckFlock() = default;
+    ~DuckFlock() override = default;
+
+    FGE_OBJ_UPDATE_DECLARE
+    FGE_OBJ_DRAW_DECLARE
+
+    void first(fge::Scene& scene) override;
+
+    std::size_t addDuck(fge::Vector2f const& position);
+    void clearDucks();
+    [[nodiscard]] std::size_t getDuckCount() const;
+
+    char const* getClassName() const override;
+    char const* getReadableClassName() const override;
+
+    [[nodiscard]] fge::RectFloat getGlobalBounds() const override;
+    [[nodiscard]] fge::RectFloat getLocalBounds() const override;
+
+private:
+    enum class States : uint8_t
+    {
+        IDLE,
+        WALKING
+    };
+    struct Frame
+    {
+        fge::RectInt _rect;
+        float _duration;
+    };
+
+    void loadAnimationGroup(char const* groupName, std::vector<Frame>& frames) const;
+    void setState(std::size_t index, States state);
+    void requestRandomWalkPath(std::size_t index);
+    void submitSprites(EntityBatch& batch, std::size_t index) const;
+
+    //Duck states, one entry per duck
+    std::vector<float> g_positionsX;
+    std::vector<float> g_positionsY;
+    std::vector<float> g_targetsX;
+    std::vector<float> g_targetsY;
+    std::vector<float> g_walkSpeeds; //F_DUCK_SPEED when walking, else 0
+    std::vector<uint8_t> g_arrived;
+    std::vector<States> g_states;
+    std::vector<uint8_t> g_flips;
+    std::vector<float> g_times;
+    std::vector<float> g_timesBeforeWalk;
+    std::vector<float> g_animationTimes;
+    std::vector<uint8_t> g_animationFrames;
+    std::vector<std::vector<fge::Vector2f>> g_walkPaths;
+    std::vector<uint32_t> g_walkPathCursors;
+    std::vector<PathfindingService::Handle> g_pathRequests; //Cancelled when the flock is destroyed
+
+    std::vector<Frame> g_idleFrames;
+    std::vector<Frame> g_walkFrames;
+
+    float g_timeBeforeQuack = 0.0f;
+    float g_anchorOffset = 0.0f;
+};
@@ -0,0 +1,124 @@
+#include "entityBatch.hpp"
+#include <algorithm>
+
+//EntityBatch
+
+FGE_OBJ_DRAW_BODY(EntityBatch)
+{
+    auto copyStates = states.copy();
+    copyStates._resTransform.set(target.requestGlobalTransform(*this, copyStates._resTransform));
+
+    for (std::size_t i = 0; i < this->g_runCount; ++i)
+    {
+        this->g_batches[i]->_sprites.draw(target, copyStates);
+    }
+}
+
+void EntityBatch::begin()
+{
+    this->g_runCount = 0;
+    for (auto& batch: this->g_batches)
+    {
+        batch->_count = 0;
+    }
+}
+void EntityBatch::submit(std::string_view textureName,
+                         fge::RectInt const& textureRect,
+                         fge::Transformable const& transform,
+                         fge::Vector2f const& position,
+                         fge::Color const& color)
+{
+    if (this->g_runCount == 0 || this->g_batches[this->g_runCount - 1]->_textureName != textureName)
+    { //Start a new run, the previous ones must stay below it
+        if (this->g_runCount == this->g_batches.size())
+        {
+            this->g_batches.emplace_back(std::make_unique<Batch>());
+        }
+
+        auto& newRun = *this->g_batches[this->g_runCount++];
+        if (newRun._textureName != textureName)
+        {
+            newRun._textureName = textureName;
+            newRun._sprites.setTexture(newRun._textureName);
+        }
+    }
+
+    auto& batch = *this->g_batches[this->g_runCount - 1];
+
+    //Reuse the instances of the previous frames
+    auto const index = batch._count++;
+    if (index == batch._sprites.getSpriteCount())
+    {
+        batch._sprites.addSprite(textureRect);
+    }
+    else
+    {
+        batch._sprites.setTextureRect(index, textureRect);
+    }
+
+    auto& spriteTransform = *batch._sprites.getTransformable(index);
+    spriteTransform = transform;
+    spriteTransform.move(position);
+    batch._sprites.setColor(index, color);
+}
+void EntityBatch::end()
+{
+    //Remove the instances that are not used anymore
+    for (auto& batch: this->g_batches)
+    {
+        while (batch->_sprites.getSpriteCount() > batch->_count)
+        {
+            batch->_sprites.removeSprite(batch->_sprites.getSpriteCount() - 1);
+        }
+    }
+}
+
+std::size_t EntityBatch::getSpriteCount() const
+{
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < this->g_runCount; ++i)
+    {
+        count += this->g_batches[i]->_count;
+    }
+    return count;
+}
+std::size_t EntityBatch::getDrawCallCount() const
+{
+    return this->g_runCount;
+}
+
+char const* EntityBatch::getClassName() const
+{
+    return "FISH_ENTITY_BATCH";
+}
+char const* EntityBatch::getReadableClassName() const
+{
+    return "entity batch";
+}
+
+fge::RectFloat EntityBatch::getGlobalBounds() const
+{
+    return this->getTransform() * this->getLocalBounds();
+}
+fge::RectFloat EntityBatch::getLocalBounds() const
+{
+    fge::RectFloat bounds{};
+    bool first = true;
+    for (std::size_t i = 0; i < this->g_runCount; ++i)
+    {
+        auto const batchBounds = this->g_batches[i]->_sprites.getLocalBounds();
+        if (first)
+        {
+            bounds = batchBounds;
+            first = false;
+            continue;
+        }
+
+        auto const left = std::min(bounds._x, batchBounds._x);
+        auto const top = std::min(bounds._y, batchBounds._y);
+        auto const right = std::max(bounds._x + bounds._width, batchBounds._x + batchBounds._width);
+        auto const bottom = std::max(bounds._y + bounds._height, batchBounds._y + batchBounds._height);
+        bounds = {{left, top}, {right - left, bottom - top}};
+    }
+    return bounds;
+}
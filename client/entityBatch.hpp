@@ -0,0 +1,58 @@
+#pragma once
+
+#include "FastEngine/C_rect.hpp"
+#include "FastEngine/object/C_object.hpp"
+#include "FastEngine/object/C_objSpriteBatches.hpp"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ * Instanced renderer for the scene entities.
+ *
+ * Entities don't draw themselves anymore, every frame they submit their sprites (texture rect, transform and tint)
+ * here. Consecutive sprites with the same texture are grouped in one run, a fge::ObjSpriteBatches (its instance
+ * buffer holds the transforms and the tints), so a crowd of players is drawn in one call per run.
+ *
+ * The submission order (the y order) is always kept: a sprite with another texture than the previous one starts a
+ * new run, the runs are drawn in order. The runs and their instances are reused from frame to frame.
+ */
+class EntityBatch : public fge::Object
+{
+public:
+    EntityBatch() = default;
+    ~EntityBatch() override = default;
+
+    FGE_OBJ_DRAW_DECLARE
+
+    void begin();
+    //The sprite transform is relative to the entity position
+    void submit(std::string_view textureName,
+                fge::RectInt const& textureRect,
+                fge::Transformable const& transform,
+                fge::Vector2f const& position,
+                fge::Color const& color);
+    void end();
+
+    [[nodiscard]] std::size_t getSpriteCount() const;
+    [[nodiscard]] std::size_t getDrawCallCount() const;
+
+    char const* getClassName() const override;
+    char const* getReadableClassName() const override;
+
+    [[nodiscard]] fge::RectFloat getGlobalBounds() const override;
+    [[nodiscard]] fge::RectFloat getLocalBounds() const override;
+
+private:
+    struct Batch
+    {
+        std::string _textureName;
+        fge::ObjSpriteBatches _sprites;
+        std::size_t _count = 0;
+    };
+
+    //Runs of this frame are the first g_runCount batches
+    std::vector<std::unique_ptr<Batch>> g_batches;
+    std::size_t g_runCount = 0;
+};
@@ -1,6 +1,9 @@
 #include "fish.hpp"
 #include "FastEngine/C_random.hpp"
 #include "FastEngine/manager/texture_manager.hpp"
+#include <algorithm>
+#include <bit>
+#include <iostream>
 
 bool FishManager::initialize()
 {
@@ -18,6 +21,8 @@ bool FishManager::initialize()
 
 void FishManager::uninitialize()
 {
+    this->g_catalog.store(nullptr);
+    this->g_catalogStorage.reset();
     BaseManager::uninitialize();
 }
 
@@ -29,8 +34,7 @@ bool FishManager::loadFromFile(std::string_view fishName,
                                FishData::Rarity rarity,
                                std::filesystem::path const& path)
 {
-    if (fishName.empty() || weightMin < 0.0f || weightMax < 0.0f || lengthMin < 0.0f || lengthMax < 0.0f ||
-        weightMin > weightMax || lengthMin > lengthMax)
+    if (fishName.empty())
     {
         return false;
     }
@@ -43,10 +47,33 @@ bool FishManager::loadFromFile(std::string_view fishName,
         }
     }
 
+    return this->loadFromTexture(fishName, weightMin, weightMax, lengthMin, lengthMax, rarity, fishName,
+                                 fge::RectInt{{0, 0}, fge::texture::gManager.getElement(fishName)->_ptr->getSize()});
+}
+bool FishManager::loadFromTexture(std::string_view fishName,
+                                  float weightMin,
+                                  float weightMax,
+                                  float lengthMin,
+                                  float lengthMax,
+                                  FishData::Rarity rarity,
+                                  std::string_view textureName,
+                                  fge::RectInt const& textureRect)
+{
+    if (fishName.empty() || weightMin < 0.0f || weightMax < 0.0f || lengthMin < 0.0f || lengthMax < 0.0f ||
+        weightMin > weightMax || lengthMin > lengthMax)
+    {
+        return false;
+    }
+    if (this->isFrozen())
+    {
+        std::cout << "FishManager: can't load the fish " << fishName << ", the catalog is frozen\n";
+        return false;
+    }
+
     DataBlockPointer block = std::make_shared<DataBlockType>();
     block->_ptr = std::make_shared<DataType>();
-    block->_ptr->_textureName = fishName;
-    block->_ptr->_textureRect = fge::RectInt{{0, 0}, fge::texture::gManager.getElement(fishName)->_ptr->getSize()};
+    block->_ptr->_textureName = textureName;
+    block->_ptr->_textureRect = textureRect;
     block->_ptr->_weightMin = weightMin;
     block->_ptr->_weightMax = weightMax;
     block->_ptr->_lengthMin = lengthMin;
@@ -61,54 +88,286 @@ bool FishManager::loadFromFile(std::string_view fishName,
     return false;
 }
 
-std::string const& FishManager::getRandomFishName() const
+void FishManager::setRarityWeight(FishData::Rarity rarity, float weight)
+{
+    this->g_rarityWeights[static_cast<std::size_t>(rarity)] = std::max(weight, 0.0f);
+}
+float FishManager::getRarityWeight(FishData::Rarity rarity) const
+{
+    return this->g_rarityWeights[static_cast<std::size_t>(rarity)];
+}
+
+bool FishManager::freeze()
 {
-    auto index = fge::_random.range<std::size_t>(0, this->size() - 1);
+    if (this->isFrozen())
+    {
+        return true;
+    }
+
+    auto catalog = std::make_unique<Catalog>();
+
+    std::vector<std::pair<std::string, FishData>> fishes;
+    {
+        auto lock = this->acquireLock();
+        for (auto it = this->begin(lock); it != this->end(lock); ++it)
+        {
+            fishes.emplace_back(it->first, *it->second->_ptr);
+        }
+    }
+
+    if (fishes.empty() || fishes.size() >= F_FISH_BAD_ID)
+    {
+        std::cout << "FishManager: can't freeze " << fishes.size() << " fishes\n";
+        return false;
+    }
+
+    std::ranges::sort(fishes, {}, &std::pair<std::string, FishData>::first);
+
+    catalog->_names.reserve(fishes.size());
+    catalog->_fishes.reserve(fishes.size());
+    for (auto& [name, data]: fishes)
+    {
+        catalog->_names.push_back(std::move(name));
+        catalog->_fishes.push_back(data);
+    }
 
-    auto lock = this->acquireLock();
-    auto it = this->begin(lock);
+    if (!buildPerfectHash(*catalog))
+    {
+        std::cout << "FishManager: can't build the perfect hash of the fish catalog\n";
+        return false;
+    }
+    this->buildAliasTable(*catalog);
 
-    while (index != 0)
+    this->g_catalogStorage = std::move(catalog);
+    this->g_catalog.store(this->g_catalogStorage.get(), std::memory_order_release);
+    return true;
+}
+bool FishManager::isFrozen() const
+{
+    return this->g_catalog.load(std::memory_order_acquire) != nullptr;
+}
+
+std::size_t FishManager::getFishCount() const
+{
+    auto const* catalog = this->g_catalog.load(std::memory_order_acquire);
+    return catalog == nullptr ? 0 : catalog->_names.size();
+}
+FishId FishManager::getFishId(std::string_view fishName) const
+{
+    auto const* catalog = this->g_catalog.load(std::memory_order_acquire);
+    if (catalog == nullptr)
     {
-        ++it;
-        --index;
+        return F_FISH_BAD_ID;
     }
 
-    return it->first;
+    auto const slot = hashName(fishName, catalog->_hashSeed) & (catalog->_slots.size() - 1);
+    auto const id = catalog->_slots[slot];
+    if (id == F_FISH_BAD_ID || catalog->_names[id] != fishName)
+    {
+        return F_FISH_BAD_ID;
+    }
+    return id;
+}
+std::string const& FishManager::getFishName(FishId id) const
+{
+    auto const* catalog = this->g_catalog.load(std::memory_order_acquire);
+    if (catalog == nullptr || id >= catalog->_names.size())
+    {
+        return this->_g_badElement->_ptr->_textureName;
+    }
+    return catalog->_names[id];
+}
+FishData const& FishManager::getFishData(FishId id) const
+{
+    auto const* catalog = this->g_catalog.load(std::memory_order_acquire);
+    if (catalog == nullptr || id >= catalog->_fishes.size())
+    {
+        return *this->_g_badElement->_ptr;
+    }
+    return catalog->_fishes[id];
+}
+FishData const& FishManager::getFishData(std::string_view fishName) const
+{
+    return this->getFishData(this->getFishId(fishName));
+}
+
+FishId FishManager::getRandomFishId() const
+{
+    auto const* catalog = this->g_catalog.load(std::memory_order_acquire);
+    if (catalog == nullptr)
+    {
+        return F_FISH_BAD_ID;
+    }
+
+    auto const column = fge::_random.range<std::size_t>(0, catalog->_names.size() - 1);
+    if (fge::_random.range(0.0f, 1.0f) < catalog->_probabilities[column])
+    {
+        return static_cast<FishId>(column);
+    }
+    return catalog->_aliases[column];
 }
 FishInstance FishManager::generateRandomFish() const
 {
-    FishInstance fishInstance;
+    auto const* catalog = this->g_catalog.load(std::memory_order_acquire);
+    if (catalog == nullptr)
+    {
+        return {};
+    }
+
+#if F_FISH_FORCE_FISH == 1
+    return this->generateFish(*catalog, this->getFishId(F_FISH_FORCE_FISHNAME));
+#else
+    return this->generateFish(*catalog, this->getRandomFishId());
+#endif
+}
+void FishManager::generateRandomFishes(std::size_t count, std::vector<FishInstance>& output) const
+{
+    auto const* catalog = this->g_catalog.load(std::memory_order_acquire);
+    if (catalog == nullptr)
+    {
+        return;
+    }
+
+    output.reserve(output.size() + count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
 #if F_FISH_FORCE_FISH == 1
-    fishInstance._name = F_FISH_FORCE_FISHNAME;
+        output.push_back(this->generateFish(*catalog, this->getFishId(F_FISH_FORCE_FISHNAME)));
 #else
-    fishInstance._name = this->getRandomFishName();
+        output.push_back(this->generateFish(*catalog, this->getRandomFishId()));
 #endif
-    auto const& fishData = this->getElement(fishInstance._name);
+    }
+}
+
+uint32_t FishManager::hashName(std::string_view fishName, uint32_t seed)
+{
+    //FNV-1a with the seed mixed in the offset basis
+    uint32_t hash = 2166136261u ^ (seed * 0x9E3779B9u);
+    for (char const c: fishName)
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 16777619u;
+    }
+    //Final avalanche, so the low bits used by the slot depend on every character
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6Bu;
+    hash ^= hash >> 13;
+    return hash;
+}
+bool FishManager::buildPerfectHash(Catalog& catalog)
+{
+    //Start with a load factor of at most 50%, and grow the table when no seed is found
+    std::size_t slotCount = std::bit_ceil(catalog._names.size() * 2);
+
+    for (std::size_t grow = 0; grow < 4; ++grow, slotCount *= 2)
+    {
+        for (uint32_t seed = 0; seed < F_FISH_HASH_MAX_TRY; ++seed)
+        {
+            catalog._slots.assign(slotCount, F_FISH_BAD_ID);
 
-    fishInstance._weight = fge::_random.range(fishData->_ptr->_weightMin, fishData->_ptr->_weightMax);
-    fishInstance._length = fge::_random.range(fishData->_ptr->_lengthMin, fishData->_ptr->_lengthMax);
+            bool collision = false;
+            for (std::size_t id = 0; id < catalog._names.size(); ++id)
+            {
+                auto& slot = catalog._slots[hashName(catalog._names[id], seed) & (slotCount - 1)];
+                if (slot != F_FISH_BAD_ID)
+                {
+                    collision = true;
+                    break;
+                }
+                slot = static_cast<FishId>(id);
+            }
+
+            if (!collision)
+            {
+                catalog._hashSeed = seed;
+                return true;
+            }
+        }
+    }
+
+    catalog._slots.clear();
+    return false;
+}
+void FishManager::buildAliasTable(Catalog& catalog) const
+{
+    auto const count = catalog._fishes.size();
+
+    double weightSum = 0.0;
+    for (auto const& fish: catalog._fishes)
+    {
+        weightSum += this->getRarityWeight(fish._rarity);
+    }
+
+    //Scale every weight so that the mean is 1
+    std::vector<double> scaled(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        scaled[i] = weightSum > 0.0 ? this->getRarityWeight(catalog._fishes[i]._rarity) *
+                                              static_cast<double>(count) / weightSum
+                                    : 1.0;
+    }
+
+    catalog._probabilities.assign(count, 1.0f);
+    catalog._aliases.resize(count);
+
+    std::vector<FishId> small;
+    std::vector<FishId> large;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        catalog._aliases[i] = static_cast<FishId>(i);
+        (scaled[i] < 1.0 ? small : large).push_back(static_cast<FishId>(i));
+    }
+
+    //Every small column is filled with the remaining of a large one (Vose's method)
+    while (!small.empty() && !large.empty())
+    {
+        auto const smallId = small.back();
+        small.pop_back();
+        auto const largeId = large.back();
+        large.pop_back();
+
+        catalog._probabilities[smallId] = static_cast<float>(scaled[smallId]);
+        catalog._aliases[smallId] = largeId;
+
+        scaled[largeId] = (scaled[largeId] + scaled[smallId]) - 1.0;
+        (scaled[largeId] < 1.0 ? small : large).push_back(largeId);
+    }
+    //Remaining columns are full (or only off by rounding errors), their probabilities are already 1
+}
+
+FishInstance FishManager::generateFish(Catalog const& catalog, FishId id) const
+{
+    if (id >= catalog._fishes.size())
+    {
+        return {};
+    }
+    auto const& fishData = catalog._fishes[id];
+
+    FishInstance fishInstance;
+    fishInstance._name = catalog._names[id];
+    fishInstance._weight = fge::_random.range(fishData._weightMin, fishData._weightMax);
+    fishInstance._length = fge::_random.range(fishData._lengthMin, fishData._lengthMax);
 
     fishInstance._starCount = 1; //Default to 1 star
 
     //Cut the weight to 3 part, where the first part is 0 star added, the second part is 1 star added, and the third part is 2 stars added
-    auto const weightDelta = (fishData->_ptr->_weightMax - fishData->_ptr->_weightMin) / 3.0f;
-    if (fishInstance._weight > fishData->_ptr->_weightMin + 2.0f * weightDelta)
+    auto const weightDelta = (fishData._weightMax - fishData._weightMin) / 3.0f;
+    if (fishInstance._weight > fishData._weightMin + 2.0f * weightDelta)
     {
         fishInstance._starCount += 2; //2 stars
     }
-    else if (fishInstance._weight > fishData->_ptr->_weightMin + weightDelta)
+    else if (fishInstance._weight > fishData._weightMin + weightDelta)
     {
         fishInstance._starCount = 1; //1 star
     }
 
     //Same for the length
-    auto const lengthDelta = (fishData->_ptr->_lengthMax - fishData->_ptr->_lengthMin) / 3.0f;
-    if (fishInstance._length > fishData->_ptr->_lengthMin + 2.0f * lengthDelta)
+    auto const lengthDelta = (fishData._lengthMax - fishData._lengthMin) / 3.0f;
+    if (fishInstance._length > fishData._lengthMin + 2.0f * lengthDelta)
     {
         fishInstance._starCount += 2; //2 stars
     }
-    else if (fishInstance._length > fishData->_ptr->_lengthMin + lengthDelta)
+    else if (fishInstance._length > fishData._lengthMin + lengthDelta)
     {
         fishInstance._starCount = 1; //1 star
     }
@@ -2,11 +2,24 @@
 
 #include "FastEngine/C_rect.hpp"
 #include "FastEngine/manager/C_baseManager.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
 
 #define F_FISH_STAR_MAX 5
 #define F_FISH_FORCE_FISH 0
 #define F_FISH_FORCE_FISHNAME "duck-fish" // Set the fish to give in minigame when F_FISH_FORCE_FISH is 1
 
+//Default selection weight of one fish, per rarity
+#define F_FISH_WEIGHT_COMMON 10.0f
+#define F_FISH_WEIGHT_UNCOMMON 4.0f
+#define F_FISH_WEIGHT_RARE 1.0f
+
+#define F_FISH_BAD_ID 0xFFFF
+#define F_FISH_HASH_MAX_TRY 1024 // Number of seeds tried before growing the perfect hash table
+
 struct FishData
 {
     enum class Rarity
@@ -25,6 +38,8 @@ struct FishData
     Rarity _rarity = Rarity::COMMON;
 };
 
+using FishId = uint16_t;
+
 struct FishInstance
 {
     std::string _name;
@@ -51,9 +66,66 @@ public:
                       float lengthMax,
                       FishData::Rarity rarity,
                       std::filesystem::path const& path);
+    bool loadFromTexture(std::string_view fishName,
+                         float weightMin,
+                         float weightMax,
+                         float lengthMin,
+                         float lengthMax,
+                         FishData::Rarity rarity,
+                         std::string_view textureName,
+                         fge::RectInt const& textureRect);
+
+    //Only used by freeze()
+    void setRarityWeight(FishData::Rarity rarity, float weight);
+    [[nodiscard]] float getRarityWeight(FishData::Rarity rarity) const;
 
-    std::string const& getRandomFishName() const;
+    /*
+     * Freeze the loaded fishes into an immutable catalog.
+     *
+     * Every fish gets a dense FishId, fishes are sorted by name so every client with the same fishes agree on the ids.
+     * The data is stored contiguously and a perfect hash is built for the name lookup.
+     * The Walker alias table used to pick a random fish, weighted by the rarity weights, is built at the same time.
+     *
+     * Once frozen, no fish can be loaded anymore and all the catalog read paths are lock-free,
+     * the locked manager functions are still working.
+     */
+    bool freeze();
+    [[nodiscard]] bool isFrozen() const;
+
+    [[nodiscard]] std::size_t getFishCount() const;
+    [[nodiscard]] FishId getFishId(std::string_view fishName) const;
+    [[nodiscard]] std::string const& getFishName(FishId id) const;
+    [[nodiscard]] FishData const& getFishData(FishId id) const;
+    [[nodiscard]] FishData const& getFishData(std::string_view fishName) const;
+
+    [[nodiscard]] FishId getRandomFishId() const;
     [[nodiscard]] FishInstance generateRandomFish() const;
+    void generateRandomFishes(std::size_t count, std::vector<FishInstance>& output) const;
+
+private:
+    struct Catalog
+    {
+        std::vector<std::string> _names;
+        std::vector<FishData> _fishes;
+
+        //Perfect hash, a name is hashed with the seed and the slot gives the id (or F_FISH_BAD_ID)
+        uint32_t _hashSeed = 0;
+        std::vector<FishId> _slots;
+
+        //Walker alias table
+        std::vector<float> _probabilities;
+        std::vector<FishId> _aliases;
+    };
+
+    [[nodiscard]] static uint32_t hashName(std::string_view fishName, uint32_t seed);
+    [[nodiscard]] static bool buildPerfectHash(Catalog& catalog);
+    void buildAliasTable(Catalog& catalog) const;
+
+    [[nodiscard]] FishInstance generateFish(Catalog const& catalog, FishId id) const;
+
+    std::array<float, 3> g_rarityWeights{F_FISH_WEIGHT_COMMON, F_FISH_WEIGHT_UNCOMMON, F_FISH_WEIGHT_RARE};
+    std::unique_ptr<Catalog const> g_catalogStorage;
+    std::atomic<Catalog const*> g_catalog{nullptr};
 };
 
 extern FishManager gFishManager;
@@ -0,0 +1,301 @@
+#include "frameTiming.hpp"
+#include "FastEngine/extra/extra_function.hpp"
+#include "SDL.h"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <string_view>
+#include <thread>
+
+namespace
+{
+
+struct PresentModeName
+{
+    std::string_view _name;
+    VkPresentModeKHR _mode;
+};
+
+constexpr std::array<PresentModeName, 3> gPresentModeNames{{{"fifo", VK_PRESENT_MODE_FIFO_KHR},
+                                                             {"mailbox", VK_PRESENT_MODE_MAILBOX_KHR},
+                                                             {"immediate", VK_PRESENT_MODE_IMMEDIATE_KHR}}};
+
+} // namespace
+
+//GraphicsConfig
+
+GraphicsConfig LoadGraphicsConfig(std::filesystem::path const& path)
+{
+    GraphicsConfig graphicsConfig;
+
+    nlohmann::json config;
+    if (!fge::LoadJsonFromFile(path, config) || !config.is_object())
+    {
+        std::cout << "Can't load " << path << ", using the default graphics settings\n";
+        config = nlohmann::json::object();
+    }
+
+    //Bad typed values are replaced by the default ones, the file is rewritten below
+    std::string presentModeName{F_GRAPHICS_DEFAULT_PRESENT_MODE};
+    if (auto const it = config.find("presentMode"); it != config.end() && it->is_string())
+    {
+        presentModeName = it->get<std::string>();
+    }
+    auto const presentModeIt = std::ranges::find(gPresentModeNames, presentModeName, &PresentModeName::_name);
+    if (presentModeIt == gPresentModeNames.end())
+    {
+        std::cout << "Unknown present mode \"" << presentModeName << "\", using \"" F_GRAPHICS_DEFAULT_PRESENT_MODE
+                  << "\"\n";
+    }
+    else
+    {
+        graphicsConfig._presentMode = presentModeIt->_mode;
+    }
+
+    if (auto const it = config.find("fpsCap"); it != config.end())
+    {
+        if (it->is_number_unsigned() && it->get<uint64_t>() <= UINT_MAX)
+        {
+            graphicsConfig._fpsCap = it->get<unsigned int>();
+        }
+        else
+        {
+            std::cout << "Bad \"fpsCap\" value, using " << F_GRAPHICS_DEFAULT_FPS_CAP << "\n";
+        }
+    }
+
+    if (auto const it = config.find("frameTimeOverlay"); it != config.end() && it->is_boolean())
+    {
+        graphicsConfig._showFrameTimeOverlay = it->get<bool>();
+    }
+
+    auto const savedPresentModeIt = std::ranges::find(gPresentModeNames, graphicsConfig._presentMode,
+                                                      &PresentModeName::_mode);
+    config = nlohmann::json{{"presentMode", savedPresentModeIt->_name},
+                            {"fpsCap", graphicsConfig._fpsCap},
+                            {"frameTimeOverlay", graphicsConfig._showFrameTimeOverlay}};
+
+    if (!fge::SaveJsonToFile(path, config, 4))
+    {
+        std::cout << "Can't save " << path << ", continuing anyway\n";
+    }
+
+    return graphicsConfig;
+}
+
+//FrameLimiter
+
+void FrameLimiter::setFpsCap(unsigned int fpsCap)
+{
+    this->g_fpsCap = fpsCap;
+    this->g_frameDuration = fpsCap == 0 ? std::chrono::steady_clock::duration{0}
+                                        : std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                  std::chrono::duration<double>{1.0 / static_cast<double>(fpsCap)});
+    this->g_deadline = std::chrono::steady_clock::now();
+}
+unsigned int FrameLimiter::getFpsCap() const
+{
+    return this->g_fpsCap;
+}
+
+void FrameLimiter::wait()
+{
+    if (this->g_fpsCap == 0)
+    {
+        return;
+    }
+
+    this->g_deadline += this->g_frameDuration;
+
+    auto now = std::chrono::steady_clock::now();
+    if (now >= this->g_deadline)
+    { //Late, don't try to catch up
+        this->g_deadline = now;
+        return;
+    }
+
+    auto const sleepTarget = this->g_deadline - std::chrono::milliseconds{1};
+    if (now < sleepTarget)
+    {
+        std::this_thread::sleep_until(sleepTarget);
+    }
+    while (std::chrono::steady_clock::now() < this->g_deadline)
+    {
+        std::this_thread::yield();
+    }
+}
+
+//FrameStats
+
+FrameStats::FrameStats()
+{
+    for (auto& samples: this->g_samples)
+    {
+        samples.resize(F_FRAME_STATS_SAMPLE_COUNT, 0.0f);
+    }
+    this->g_sortBuffer.reserve(F_FRAME_STATS_SAMPLE_COUNT);
+}
+
+void FrameStats::beginFrame()
+{
+    this->g_frameStart = std::chrono::steady_clock::now();
+    this->g_lastMark = this->g_frameStart;
+    this->g_currentFrame.fill(0.0f);
+}
+void FrameStats::mark(Metrics metric)
+{
+    auto const now = std::chrono::steady_clock::now();
+    this->g_currentFrame[metric] += std::chrono::duration<float, std::milli>(now - this->g_lastMark).count();
+    this->g_lastMark = now;
+}
+void FrameStats::endFrame()
+{
+    this->g_currentFrame[METRIC_FRAME] =
+            std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - this->g_frameStart).count();
+
+    for (std::size_t i = 0; i < METRIC_COUNT; ++i)
+    {
+        this->g_samples[i][this->g_nextSample] = this->g_currentFrame[i];
+    }
+    this->g_nextSample = (this->g_nextSample + 1) % F_FRAME_STATS_SAMPLE_COUNT;
+    this->g_sampleCount = std::min<std::size_t>(this->g_sampleCount + 1, F_FRAME_STATS_SAMPLE_COUNT);
+}
+
+std::size_t FrameStats::getSampleCount() const
+{
+    return this->g_sampleCount;
+}
+FrameStats::Summary FrameStats::computeSummary(Metrics metric) const
+{
+    Summary summary;
+    if (this->g_sampleCount == 0)
+    {
+        return summary;
+    }
+
+    auto const& samples = this->g_samples[metric];
+    this->g_sortBuffer.assign(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(this->g_sampleCount));
+    std::ranges::sort(this->g_sortBuffer, std::greater<>{});
+
+    auto const averageOfSlowest = [&](std::size_t count) {
+        count = std::clamp<std::size_t>(count, 1, this->g_sortBuffer.size());
+        auto const end = this->g_sortBuffer.begin() + static_cast<std::ptrdiff_t>(count);
+        return std::accumulate(this->g_sortBuffer.begin(), end, 0.0f) / static_cast<float>(count);
+    };
+
+    summary._averageMs = averageOfSlowest(this->g_sortBuffer.size());
+    summary._low1Ms = averageOfSlowest(this->g_sortBuffer.size() / 100);
+    summary._low01Ms = averageOfSlowest(this->g_sortBuffer.size() / 1000);
+    return summary;
+}
+
+FrameStats gFrameStats;
+
+//FrameTimeOverlay
+
+FGE_OBJ_UPDATE_BODY(FrameTimeOverlay)
+{
+    if (!this->g_visible)
+    {
+        return;
+    }
+
+    this->g_time += fge::DurationToSecondFloat(deltaTime);
+    if (this->g_time >= F_FRAME_OVERLAY_REFRESH_S)
+    {
+        this->g_time = 0.0f;
+        this->refreshText();
+    }
+}
+FGE_OBJ_DRAW_BODY(FrameTimeOverlay)
+{
+    if (!this->g_visible)
+    {
+        return;
+    }
+
+    auto const viewBackup = target.getView();
+    target.setView(target.getDefaultView());
+
+    auto copyStates = states.copy();
+    copyStates._resTransform.set(target.requestGlobalTransform(*this, copyStates._resTransform));
+
+    this->g_text.draw(target, copyStates);
+
+    target.setView(viewBackup);
+}
+
+void FrameTimeOverlay::first([[maybe_unused]] fge::Scene& scene)
+{
+    this->_drawMode = DrawModes::DRAW_ALWAYS_DRAWN;
+
+    this->g_text.setFont("default");
+    this->g_text.setCharacterSize(32);
+    this->g_text.setFillColor(fge::Color::White);
+    this->g_text.setOutlineColor(fge::Color::Black);
+    this->g_text.setOutlineThickness(1.0f);
+    this->g_text.setPosition({10.0f, 10.0f});
+
+    this->refreshText();
+}
+
+void FrameTimeOverlay::setVisible(bool visible)
+{
+    this->g_visible = visible;
+    this->g_time = 0.0f;
+    if (visible)
+    {
+        this->refreshText();
+    }
+}
+bool FrameTimeOverlay::isVisible() const
+{
+    return this->g_visible;
+}
+
+char const* FrameTimeOverlay::getClassName() const
+{
+    return "FISH_FRAME_TIME_OVERLAY";
+}
+char const* FrameTimeOverlay::getReadableClassName() const
+{
+    return "frame time overlay";
+}
+
+fge::RectFloat FrameTimeOverlay::getGlobalBounds() const
+{
+    return this->getTransform() * this->g_text.getGlobalBounds();
+}
+fge::RectFloat FrameTimeOverlay::getLocalBounds() const
+{
+    return this->g_text.getGlobalBounds();
+}
+
+void FrameTimeOverlay::refreshText()
+{
+    constexpr std::array<std::pair<FrameStats::Metrics, char const*>, FrameStats::METRIC_COUNT> metrics{
+            {{FrameStats::METRIC_UPDATE, "update"},
+             {FrameStats::METRIC_DRAW, "draw"},
+             {FrameStats::METRIC_PRESENT, "present"},
+             {FrameStats::METRIC_FRAME, "frame"}}};
+
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(2);
+
+    auto const frameSummary = gFrameStats.computeSummary(FrameStats::METRIC_FRAME);
+    stream << "fps " << (frameSummary._averageMs > 0.0f ? 1000.0f / frameSummary._averageMs : 0.0f) << " ("
+           << gFrameStats.getSampleCount() << " frames)\n";
+    stream << "ms: avg / 1% low / 0.1% low\n";
+
+    for (auto const& [metric, name]: metrics)
+    {
+        auto const summary = gFrameStats.computeSummary(metric);
+        stream << name << ": " << summary._averageMs << " / " << summary._low1Ms << " / " << summary._low01Ms << '\n';
+    }
+
+    this->g_text.setString(stream.str());
+}
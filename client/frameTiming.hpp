@@ -0,0 +1,129 @@
+#pragma once
+
+#include "FastEngine/graphic/C_renderWindow.hpp"
+#include "FastEngine/object/C_objText.hpp"
+#include "FastEngine/object/C_object.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#define F_GRAPHICS_CONFIG_FILE "graphics.json"
+#define F_GRAPHICS_DEFAULT_PRESENT_MODE "fifo"
+#define F_GRAPHICS_DEFAULT_FPS_CAP 0 // 0 is unlimited
+
+#define F_FRAME_STATS_SAMPLE_COUNT 2000 // Enough samples to have 2 frames in the 0.1% low
+#define F_FRAME_OVERLAY_REFRESH_S 0.25f
+#define F_FRAME_OVERLAY_KEY SDLK_F3
+
+struct GraphicsConfig
+{
+    VkPresentModeKHR _presentMode = VK_PRESENT_MODE_FIFO_KHR;
+    unsigned int _fpsCap = F_GRAPHICS_DEFAULT_FPS_CAP;
+    bool _showFrameTimeOverlay = false;
+};
+
+//Load the config file (written back with every value, so the user can see the available settings)
+GraphicsConfig LoadGraphicsConfig(std::filesystem::path const& path);
+
+/*
+ * Sleep at the end of a frame to respect a fps cap.
+ *
+ * The frame deadline is advanced by a fixed duration (so the frame rate doesn't drift), the thread sleeps until
+ * the last millisecond then spins as the sleep granularity is too coarse on some systems.
+ */
+class FrameLimiter
+{
+public:
+    FrameLimiter() = default;
+
+    void setFpsCap(unsigned int fpsCap);
+    [[nodiscard]] unsigned int getFpsCap() const;
+
+    void wait();
+
+private:
+    unsigned int g_fpsCap = 0;
+    std::chrono::steady_clock::duration g_frameDuration{0};
+    std::chrono::steady_clock::time_point g_deadline{};
+};
+
+/*
+ * Rolling frame time statistics.
+ *
+ * Every frame records the cpu time of the update, the draw and the present (acquire + submit + present),
+ * the average and the lows are computed on the last F_FRAME_STATS_SAMPLE_COUNT frames.
+ * A 1% low is the average of the 1% slowest frames.
+ */
+class FrameStats
+{
+public:
+    enum Metrics : std::size_t
+    {
+        METRIC_UPDATE,
+        METRIC_DRAW,
+        METRIC_PRESENT,
+        METRIC_FRAME,
+
+        METRIC_COUNT
+    };
+
+    struct Summary
+    {
+        float _averageMs = 0.0f;
+        float _low1Ms = 0.0f;
+        float _low01Ms = 0.0f;
+    };
+
+    FrameStats();
+
+    void beginFrame();
+    //Record the time elapsed since the last mark of this frame
+    void mark(Metrics metric);
+    void endFrame();
+
+    [[nodiscard]] std::size_t getSampleCount() const;
+    [[nodiscard]] Summary computeSummary(Metrics metric) const;
+
+private:
+    std::array<std::vector<float>, METRIC_COUNT> g_samples;
+    std::array<float, METRIC_COUNT> g_currentFrame{};
+    std::size_t g_nextSample = 0;
+    std::size_t g_sampleCount = 0;
+
+    std::chrono::steady_clock::time_point g_frameStart{};
+    std::chrono::steady_clock::time_point g_lastMark{};
+
+    mutable std::vector<float> g_sortBuffer;
+};
+
+extern FrameStats gFrameStats;
+
+class FrameTimeOverlay : public fge::Object
+{
+public:
+    FrameTimeOverlay() = default;
+    ~FrameTimeOverlay() override = default;
+
+    FGE_OBJ_UPDATE_DECLARE
+    FGE_OBJ_DRAW_DECLARE
+
+    void first(fge::Scene& scene) override;
+
+    void setVisible(bool visible);
+    [[nodiscard]] bool isVisible() const;
+
+    char const* getClassName() const override;
+    char const* getReadableClassName() const override;
+
+    [[nodiscard]] fge::RectFloat getGlobalBounds() const override;
+    [[nodiscard]] fge::RectFloat getLocalBounds() const override;
+
+private:
+    void refreshText();
+
+    fge::ObjText g_text;
+    float g_time = 0.0f;
+    bool g_visible = false;
+};
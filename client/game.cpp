@@ -2,7 +2,11 @@
 #include "../share/player.hpp"
 #include "FastEngine/C_random.hpp"
 #include "FastEngine/manager/audio_manager.hpp"
+#include "assetLoader.hpp"
 #include "fish.hpp"
+#include "textureAtlas.hpp"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 //GameHandler
@@ -19,6 +23,7 @@ GameHandler::GameHandler(fge::Scene& scene, fge::net::ClientSideNetUdp& network)
 }
 GameHandler::~GameHandler()
 {
+    this->g_collectionJournal.stop();
     b2DestroyWorld(this->g_bworld);
 }
 
@@ -34,25 +39,111 @@ b2WorldId GameHandler::getWorld() const
 }
 void GameHandler::pushStaticCollider(fge::RectFloat const& rect)
 {
-    b2BodyDef groundBodyDef = b2DefaultBodyDef();
+    this->g_staticColliders.push(rect);
+}
+std::size_t GameHandler::buildStaticColliders()
+{
+    this->g_staticColliders.merge();
+    //The builder is cleared by build()
+    auto const colliderCount = this->g_staticColliders.getRects().size();
+    this->g_staticBody = this->g_staticColliders.build(this->g_bworld);
+    return colliderCount;
+}
+void GameHandler::updateWorld(fge::DeltaTime const& deltaTime)
+{
+    this->g_physicsAccumulator += deltaTime;
 
-    auto const position = rect.getPosition() + rect.getSize() / 2.0f;
-    groundBodyDef.position = {position.x, position.y};
-    groundBodyDef.type = b2_staticBody;
+    float const timeStep = fge::DurationToSecondFloat(this->g_physicsStep);
+
+    unsigned int stepCount = 0;
+    while (this->g_physicsAccumulator >= this->g_physicsStep)
+    {
+        if (stepCount == F_PHYSICS_MAX_STEPS_PER_FRAME)
+        { //Too far behind, drop the remaining time instead of spiraling
+            this->g_physicsAccumulator = this->g_physicsAccumulator % this->g_physicsStep;
+            break;
+        }
 
-    b2BodyId bodyId = b2CreateBody(this->g_bworld, &groundBodyDef);
+        for (auto& body: this->g_interpolatedBodies)
+        {
+            if (b2Body_IsValid(body._bodyId))
+            {
+                body._previous = b2Body_GetPosition(body._bodyId);
+            }
+        }
 
-    b2Polygon groundBox = b2MakeBox(rect._width / 2.0f, rect._height / 2.0f);
+        b2World_Step(this->g_bworld, timeStep, F_PHYSICS_SUBSTEP_COUNT);
+        this->g_physicsAccumulator -= this->g_physicsStep;
+        ++stepCount;
+    }
 
-    b2ShapeDef groundShapeDef = b2DefaultShapeDef();
-    b2CreatePolygonShape(bodyId, &groundShapeDef, &groundBox);
+    if (stepCount != 0)
+    {
+        for (auto& body: this->g_interpolatedBodies)
+        {
+            if (b2Body_IsValid(body._bodyId))
+            {
+                body._current = b2Body_GetPosition(body._bodyId);
+            }
+        }
+    }
+}
+void GameHandler::setPhysicsTickRate(unsigned int tickRate)
+{
+    tickRate = std::max(tickRate, 1u);
+    this->g_physicsStep = std::chrono::duration_cast<fge::DeltaTime>(std::chrono::microseconds{1'000'000 / tickRate});
 }
-void GameHandler::updateWorld()
+unsigned int GameHandler::getPhysicsTickRate() const
 {
-    constexpr float timeStep = 1.0f / 60.0f;
-    constexpr int subStepCount = 4;
+    return static_cast<unsigned int>(std::chrono::seconds{1} / this->g_physicsStep);
+}
+float GameHandler::getPhysicsAlpha() const
+{
+    return std::clamp(fge::DurationToSecondFloat(this->g_physicsAccumulator) /
+                              fge::DurationToSecondFloat(this->g_physicsStep),
+                      0.0f, 1.0f);
+}
 
-    b2World_Step(this->g_bworld, timeStep, subStepCount);
+void GameHandler::registerInterpolatedBody(b2BodyId bodyId)
+{
+    auto const position = b2Body_GetPosition(bodyId);
+    for (auto& body: this->g_interpolatedBodies)
+    {
+        if (B2_ID_EQUALS(body._bodyId, bodyId))
+        {
+            body._previous = position;
+            body._current = position;
+            return;
+        }
+    }
+    this->g_interpolatedBodies.push_back({bodyId, position, position});
+}
+void GameHandler::unregisterInterpolatedBody(b2BodyId bodyId)
+{
+    std::erase_if(this->g_interpolatedBodies,
+                  [&](InterpolatedBody const& body) { return B2_ID_EQUALS(body._bodyId, bodyId); });
+}
+fge::Vector2f GameHandler::getInterpolatedPosition(b2BodyId bodyId) const
+{
+    for (auto const& body: this->g_interpolatedBodies)
+    {
+        if (B2_ID_EQUALS(body._bodyId, bodyId))
+        {
+            auto const position = b2Lerp(body._previous, body._current, this->getPhysicsAlpha());
+            return {position.x, position.y};
+        }
+    }
+    auto const position = b2Body_GetPosition(bodyId);
+    return {position.x, position.y};
+}
+
+DepthSorter& GameHandler::getDepthSorter()
+{
+    return this->g_depthSorter;
+}
+SnapshotClock& GameHandler::getSnapshotClock()
+{
+    return this->g_snapshotClock;
 }
 
 Player* GameHandler::getPlayer() const
@@ -70,14 +161,16 @@ fge::Scene& GameHandler::getScene() const
 
 void GameHandler::update(fge::DeltaTime const& deltaTime)
 {
-    this->updateWorld();
+    this->updateWorld(deltaTime);
+    this->g_depthSorter.update(*this->g_scene);
 
     this->g_checkTime += deltaTime;
     if (this->g_checkTime >= std::chrono::milliseconds(F_GAME_CHECK_TIME_MS))
     {
         auto player = this->getPlayer();
 
-        if (player->isFishing())
+        //The minigame needs the deferred assets (fishes, sprites and audio)
+        if (player->isFishing() && gAssetLoader.isDone(AssetLoader::Groups::DEFERRED))
         {
             if (--this->g_fishCountDown == 0)
             {
@@ -114,36 +207,10 @@ void GameHandler::pushChatEvent(std::string const& chat) const
 
 bool GameHandler::loadPlayerCollectionFromFile()
 {
-    this->g_fishPlayerCollection.clear();
-
-    nlohmann::json jsonFish;
-    if (!fge::LoadJsonFromFile(F_COLLECTION_FILE, jsonFish))
-    {
-        return false;
-    }
-
-    for (auto const& [name, instance]: jsonFish.items())
-    {
-        auto const fishInstance = instance.get<FishInstance>();
-        this->g_fishPlayerCollection[name] = fishInstance;
-        if (name != fishInstance._name)
-        {
-            return false;
-        }
-    }
-
-    return true;
-}
-void GameHandler::savePlayerCollectionToFile() const
-{
-    nlohmann::json jsonFish;
-
-    for (auto const& [name, instance]: this->g_fishPlayerCollection)
-    {
-        jsonFish[name] = instance;
-    }
-
-    fge::SaveJsonToFile(F_COLLECTION_FILE, jsonFish);
+    auto const loaded = this->g_collectionJournal.load(F_COLLECTION_FILE, F_COLLECTION_JOURNAL_FILE,
+                                                       this->g_fishPlayerCollection);
+    this->g_collectionJournal.start();
+    return loaded;
 }
 GameHandler::FishCollectionData const& GameHandler::getFishPlayerCollection() const
 {
@@ -155,7 +222,7 @@ GameHandler::NewRecords_t GameHandler::addFishToPlayerCollection(FishInstance co
     if (it == this->g_fishPlayerCollection.end())
     {
         this->g_fishPlayerCollection.emplace(fish._name, fish);
-        this->savePlayerCollectionToFile();
+        this->g_collectionJournal.push(fish);
         return RECORD_ALL;
     }
 
@@ -183,14 +250,14 @@ GameHandler::NewRecords_t GameHandler::addFishToPlayerCollection(FishInstance co
 
     if (newRecords != RECORD_NONE)
     {
-        this->savePlayerCollectionToFile();
+        this->g_collectionJournal.push(it->second);
     }
     return newRecords;
 }
 
 void GameHandler::openPlayerCollection()
 {
-    if (this->isPlayerCollectionOpen())
+    if (this->isPlayerCollectionOpen() || !gAssetLoader.isDone(AssetLoader::Groups::DEFERRED))
     {
         return;
     }
@@ -211,6 +278,75 @@ bool GameHandler::isPlayerCollectionOpen() const
 
 std::unique_ptr<GameHandler> gGameHandler;
 
+//ProgressRing
+
+FGE_OBJ_DRAW_BODY(ProgressRing)
+{
+    if (this->g_drawnVertexCount < 4)
+    {
+        return;
+    }
+
+    auto copyStates = states.copy(&this->g_vertices);
+    copyStates._resTransform.set(target.requestGlobalTransform(*this, copyStates._resTransform));
+    copyStates._resInstances.setVertexCount(this->g_drawnVertexCount);
+
+    target.draw(copyStates);
+}
+
+void ProgressRing::create(float innerRadius, float outerRadius, std::size_t segmentCount, fge::Color const& color)
+{
+    this->g_segmentCount = std::max<std::size_t>(segmentCount, 3);
+    this->g_outerRadius = outerRadius;
+
+    auto const vertexCount = 2 * (this->g_segmentCount + 1);
+    this->g_vertices.create(vertexCount, VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP);
+
+    for (std::size_t i = 0; i <= this->g_segmentCount; ++i)
+    { //y is down, so a counterclockwise angle goes up
+        auto const angle = 2.0f * static_cast<float>(FGE_MATH_PI) * static_cast<float>(i) /
+                           static_cast<float>(this->g_segmentCount);
+        fge::Vector2f const direction{std::cos(angle), -std::sin(angle)};
+
+        this->g_vertices[2 * i]._position = direction * outerRadius;
+        this->g_vertices[2 * i]._color = color;
+        this->g_vertices[2 * i + 1]._position = direction * innerRadius;
+        this->g_vertices[2 * i + 1]._color = color;
+    }
+
+    this->setProgress(this->g_progress);
+}
+
+void ProgressRing::setProgress(float progress)
+{
+    this->g_progress = std::clamp(progress, 0.0f, 1.0f);
+
+    auto const segments = static_cast<std::size_t>(this->g_progress * static_cast<float>(this->g_segmentCount));
+    this->g_drawnVertexCount = segments == 0 ? 0 : static_cast<uint32_t>(2 * (segments + 1));
+}
+float ProgressRing::getProgress() const
+{
+    return this->g_progress;
+}
+
+char const* ProgressRing::getClassName() const
+{
+    return "FISH_PROGRESS_RING";
+}
+char const* ProgressRing::getReadableClassName() const
+{
+    return "progress ring";
+}
+
+fge::RectFloat ProgressRing::getGlobalBounds() const
+{
+    return this->getTransform() * this->getLocalBounds();
+}
+fge::RectFloat ProgressRing::getLocalBounds() const
+{
+    return {{-this->g_outerRadius, -this->g_outerRadius}, {2.0f * this->g_outerRadius, 2.0f * this->g_outerRadius}};
+}
+
 //Minigame
 
 FGE_OBJ_UPDATE_BODY(Minigame)
@@ -230,10 +366,7 @@ FGE_OBJ_UPDATE_BODY(Minigame)
         return;
     case States::WAITING_INPUT:
     {
-        auto const newAngle = fge::ConvertRange(this->g_currentTime, 0.0f, F_MINIGAME_WAITING_KEY_TIME, 0.0f, 360.0f);
-        this->g_keyToPressSurface.addUnfilledHollowCircle(
-                32, 32, 0.0f, newAngle, 20, 32, fge::Surface::AngleDirections::CounterClockwise, {140, 140, 140, 200});
-        this->g_keyToPressTexture->update(this->g_keyToPressSurface.get(), {0, 0});
+        this->g_keyToPressRing.setProgress(this->g_currentTime / F_MINIGAME_WAITING_KEY_TIME);
 
         if (event.getKeyUnicode() == this->g_unicodeKeyToPress)
         {
@@ -366,7 +499,7 @@ FGE_OBJ_DRAW_BODY(Minigame)
         this->g_keyToPress.draw(target, states);
         return;
     case States::WAITING_INPUT:
-        this->g_keyToPressCircle.draw(target, states);
+        this->g_keyToPressRing.draw(target, states);
         this->g_keyToPress.draw(target, states);
         return;
     case States::FISH_TIME:
@@ -437,22 +570,17 @@ void Minigame::first(fge::Scene& scene)
     this->g_keyToPress.setPosition(gGameHandler->getPlayer()->getPosition());
     this->g_keyToPress.setScale(0.0f);
 
-    this->g_keyToPressSurface.create(64, 64, fge::Color::Transparent);
-    this->g_keyToPressTexture = std::make_shared<fge::vulkan::TextureImage>(fge::vulkan::GetActiveContext());
-    this->g_keyToPressTexture->create(this->g_keyToPressSurface.get());
-
-    this->g_keyToPressCircle.setTexture(this->g_keyToPressTexture, true);
-    this->g_keyToPressCircle.centerOriginFromLocalBounds();
-    this->g_keyToPressCircle.setPosition(this->g_keyToPress.getPosition());
-    this->g_keyToPressCircle.scale(0.2f);
+    this->g_keyToPressRing.create(F_MINIGAME_KEY_RING_INNER_RADIUS, F_MINIGAME_KEY_RING_OUTER_RADIUS,
+                                  F_MINIGAME_KEY_RING_SEGMENTS, {140, 140, 140, 200});
+    this->g_keyToPressRing.setPosition(this->g_keyToPress.getPosition());
 
     //Generate fish reward
     this->g_fishReward = gFishManager.generateRandomFish();
-    auto const fish = gFishManager.getElement(this->g_fishReward._name);
+    auto const& fish = gFishManager.getFishData(this->g_fishReward._name);
 
     //Generate difficulty
     this->g_difficulty = F_MINIGAME_DIFFICULTY_START;
-    switch (fish->_ptr->_rarity)
+    switch (fish._rarity)
     {
     case FishData::Rarity::COMMON:
         this->g_difficulty += F_MINIGAME_DIFFICULTY_RARITY_COMMON;
@@ -561,9 +689,9 @@ FishAward::FishAward(FishInstance const& fishReward, GameHandler::NewRecords_t n
     this->g_newRecords = newRecords;
     this->g_fishReward = fishReward;
 
-    auto const fish = gFishManager.getElement(this->g_fishReward._name);
-    this->g_fish.setTexture(fish->_ptr->_textureName);
-    this->g_fish.setTextureRect(fish->_ptr->_textureRect);
+    auto const& fish = gFishManager.getFishData(this->g_fishReward._name);
+    this->g_fish.setTexture(fish._textureName);
+    this->g_fish.setTextureRect(fish._textureRect);
     this->g_fish.scale(20.0f);
     this->g_fish.centerOriginFromLocalBounds();
 }
@@ -650,7 +778,7 @@ void FishAward::first(fge::Scene& scene)
         starsTextureRect._y = 16;
     }
 
-    auto const rarity = gFishManager.getElement(this->g_fishReward._name)->_ptr->_rarity;
+    auto const rarity = gFishManager.getFishData(this->g_fishReward._name)._rarity;
     switch (rarity)
     {
     case FishData::Rarity::COMMON:
@@ -680,7 +808,7 @@ void FishAward::first(fge::Scene& scene)
     this->g_text.setOutlineColor(fge::Color::Black);
     this->g_text.setOutlineThickness(1.8f);
 
-    this->g_text.setString("You caught a fish!\n   -> " + this->g_fish.getTexture().getName());
+    this->g_text.setString("You caught a fish!\n   -> " + this->g_fishReward._name);
     this->g_text.centerOriginFromLocalBounds();
     this->g_text.setPosition({0.0f, 200.0f});
 
@@ -755,11 +883,12 @@ fge::RectFloat FishAward::getLocalBounds() const
 
 //MultiplayerFishAward
 
-MultiplayerFishAward::MultiplayerFishAward(std::string const& fishName, fge::Vector2f const& position)
+MultiplayerFishAward::MultiplayerFishAward(std::string const& fishName, fge::Vector2f const& position) :
+        g_fishName(fishName)
 {
-    auto const fish = gFishManager.getElement(fishName);
-    this->g_fish.setTexture(fish->_ptr->_textureName);
-    this->g_fish.setTextureRect(fish->_ptr->_textureRect);
+    auto const& fish = gFishManager.getFishData(fishName);
+    this->g_fish.setTexture(fish._textureName);
+    this->g_fish.setTextureRect(fish._textureRect);
     this->g_fish.scale(0.6f);
     this->g_fish.centerOriginFromLocalBounds();
 
@@ -812,7 +941,7 @@ void MultiplayerFishAward::first(fge::Scene& scene)
     this->g_text.setFont("default");
     this->g_text.setCharacterSize(40);
     this->g_text.scale(0.3f);
-    this->g_text.setString(this->g_fish.getTexture().getName());
+    this->g_text.setString(this->g_fishName);
     this->g_text.setFillColor(fge::Color::White);
     this->g_text.setOutlineColor(fge::Color::Black);
     this->g_text.setOutlineThickness(1.0f);
@@ -862,16 +991,8 @@ FGE_OBJ_DRAW_BODY(FishCollection)
     auto const startIndex = this->g_currentPage * (F_COLLECTION_MAX_COL * F_COLLECTION_MAX_ROW);
     auto const endIndex = startIndex + F_COLLECTION_MAX_COL * F_COLLECTION_MAX_ROW * 2;
 
-    for (std::size_t i = startIndex; i < endIndex; ++i)
-    {
-        if (i >= this->g_fishEntries.size())
-        {
-            break;
-        }
+    this->g_fishSprites.draw(target, copyStates);
 
-        auto const& entry = this->g_fishEntries[i];
-        entry._sprite.draw(target, copyStates);
-    }
     for (std::size_t i = startIndex; i < endIndex; ++i)
     {
         if (i >= this->g_fishEntries.size())
@@ -893,12 +1014,15 @@ void FishCollection::first(fge::Scene& scene)
 
     auto const screenCenter = static_cast<fge::Vector2f>(scene.getLinkedRenderTarget()->getSize()) / 2.0f;
 
-    this->g_book.setTexture("book_1");
+    this->g_book.setTexture(gCollectionAtlas.getName());
+    this->g_book.setTextureRect(gCollectionAtlas.getRect("book_1"));
     this->g_book.scale(14.0f);
     this->g_book.centerOriginFromLocalBounds();
     this->g_book.setPosition(screenCenter);
 
-    this->g_buttonClose->setTexture("close_1");
+    this->g_buttonClose->setTexture(gCollectionAtlas.getName());
+    this->g_buttonClose->setTextureOnRect(gCollectionAtlas.getRect("close_1"));
+    this->g_buttonClose->setTextureOffRect(gCollectionAtlas.getRect("close_1"));
     this->g_buttonClose->setPosition(screenCenter + fge::Vector2f{550.0f, -320.0f});
     this->g_buttonClose->scale(4.0f);
     this->g_buttonClose->ownViewExplicitlySetDefaultView(true);
@@ -911,9 +1035,9 @@ void FishCollection::first(fge::Scene& scene)
         }
     });
 
-    this->g_buttonNextPage->setTexture("arrows");
-    this->g_buttonNextPage->setTextureOnRect({{16, 0}, {16, 16}});
-    this->g_buttonNextPage->setTextureOffRect({{16, 0}, {16, 16}});
+    this->g_buttonNextPage->setTexture(gCollectionAtlas.getName());
+    this->g_buttonNextPage->setTextureOnRect(gCollectionAtlas.getRect("arrows", {{16, 0}, {16, 16}}));
+    this->g_buttonNextPage->setTextureOffRect(gCollectionAtlas.getRect("arrows", {{16, 0}, {16, 16}}));
     this->g_buttonNextPage->setPosition(screenCenter + fge::Vector2f{560.0f, 170.0f});
     this->g_buttonNextPage->scale(5.0f);
     this->g_buttonNextPage->ownViewExplicitlySetDefaultView(true);
@@ -924,17 +1048,19 @@ void FishCollection::first(fge::Scene& scene)
             return;
         }
         this->g_currentPage += 2;
+        this->updatePageSprites();
     });
 
-    this->g_buttonLastPage->setTexture("arrows");
-    this->g_buttonLastPage->setTextureOnRect({{0, 0}, {16, 16}});
-    this->g_buttonLastPage->setTextureOffRect({{0, 0}, {16, 16}});
+    this->g_buttonLastPage->setTexture(gCollectionAtlas.getName());
+    this->g_buttonLastPage->setTextureOnRect(gCollectionAtlas.getRect("arrows", {{0, 0}, {16, 16}}));
+    this->g_buttonLastPage->setTextureOffRect(gCollectionAtlas.getRect("arrows", {{0, 0}, {16, 16}}));
     this->g_buttonLastPage->setPosition(screenCenter + fge::Vector2f{-560.0f, 170.0f});
     this->g_buttonLastPage->scale(5.0f);
     this->g_buttonLastPage->ownViewExplicitlySetDefaultView(true);
     this->g_buttonLastPage->centerOriginFromLocalBounds();
     this->g_buttonLastPage->_onButtonPressed.addLambda([&](fge::ObjButton* button) {
         this->g_currentPage -= std::min(this->g_currentPage, static_cast<std::size_t>(2));
+        this->updatePageSprites();
     });
 
     auto const& fishCollection = gGameHandler->getFishPlayerCollection();
@@ -948,7 +1074,7 @@ void FishCollection::first(fge::Scene& scene)
         std::cout << "\tcol: " << (index % F_COLLECTION_MAX_COL) << " row: " << (index / F_COLLECTION_MAX_COL)
                   << std::endl;
 
-        auto fishData = gFishManager.getElement(instance._name);
+        auto const& fishData = gFishManager.getFishData(instance._name);
 
         fge::Vector2f positionOffset = {-450.0f, -240.0f};
         if (!leftPage)
@@ -956,26 +1082,23 @@ void FishCollection::first(fge::Scene& scene)
             positionOffset.x = 200.0f;
         }
 
-        entry._sprite.setTexture(fishData->_ptr->_textureName);
-        entry._sprite.setTextureRect(fishData->_ptr->_textureRect);
-        entry._sprite.centerOriginFromLocalBounds();
-        entry._sprite.scale(8.0f);
-        entry._sprite.setPosition(screenCenter + positionOffset +
-                                  fge::Vector2f{static_cast<float>(index % F_COLLECTION_MAX_COL) * 240.0f,
-                                                static_cast<float>(index / F_COLLECTION_MAX_COL) * 150.0f});
+        entry._textureRect = fishData._textureRect;
+        entry._position = screenCenter + positionOffset +
+                          fge::Vector2f{static_cast<float>(index % F_COLLECTION_MAX_COL) * 240.0f,
+                                        static_cast<float>(index / F_COLLECTION_MAX_COL) * 150.0f};
 
         entry._textName.setString(instance._name);
         entry._textName.setFont("default");
         entry._textName.setCharacterSize(24);
         entry._textName.setFillColor(fge::Color::Black);
-        entry._textName.setPosition(entry._sprite.getPosition() + fge::Vector2f{-70.0f, 30.0f});
+        entry._textName.setPosition(entry._position + fge::Vector2f{-70.0f, 30.0f});
 
         entry._textAttributes.setString(std::format("Length: {:.2f} cm\nWeight: {:.2f} g\nStars: {}", instance._length,
                                                     instance._weight, instance._starCount));
         entry._textAttributes.setFont("default");
         entry._textAttributes.setCharacterSize(24);
         entry._textAttributes.setFillColor(fge::Color::Black);
-        entry._textAttributes.setPosition(entry._sprite.getPosition() + fge::Vector2f{-70.0f, 50.0f});
+        entry._textAttributes.setPosition(entry._position + fge::Vector2f{-70.0f, 50.0f});
 
         ++index;
 
@@ -988,9 +1111,31 @@ void FishCollection::first(fge::Scene& scene)
     this->g_maxPage = fishCollection.size() / (F_COLLECTION_MAX_COL * F_COLLECTION_MAX_ROW);
     this->g_currentPage = 0;
 
+    this->g_fishSprites.setTexture(gFishAtlas.getName());
+    this->updatePageSprites();
+
     std::cout << "current: " << this->g_currentPage << " max: " << this->g_maxPage << std::endl;
 }
 
+void FishCollection::updatePageSprites()
+{
+    this->g_fishSprites.clear();
+
+    auto const startIndex = this->g_currentPage * (F_COLLECTION_MAX_COL * F_COLLECTION_MAX_ROW);
+    auto const endIndex = std::min(startIndex + F_COLLECTION_MAX_COL * F_COLLECTION_MAX_ROW * 2,
+                                   this->g_fishEntries.size());
+
+    for (std::size_t i = startIndex; i < endIndex; ++i)
+    {
+        auto const& entry = this->g_fishEntries[i];
+
+        auto& transform = this->g_fishSprites.addSprite(entry._textureRect);
+        transform.setOrigin(static_cast<fge::Vector2f>(entry._textureRect.getSize()) / 2.0f);
+        transform.scale(8.0f);
+        transform.setPosition(entry._position);
+    }
+}
+
 void FishCollection::callbackRegister(fge::Event& event, fge::GuiElementHandler* guiElementHandlerPtr)
 {
     this->g_buttonNextPage->callbackRegister(event, guiElementHandlerPtr);
@@ -8,13 +8,18 @@
 #include "FastEngine/object/C_objSpriteBatches.hpp"
 #include "FastEngine/object/C_objText.hpp"
 #include "FastEngine/object/C_object.hpp"
+#include "FastEngine/vulkan/C_vertexBuffer.hpp"
 
 #include "../share/network.hpp"
 #include "box2d/box2d.h"
 #include "updater.hpp"
 #include <memory>
 
+#include "colliderBuilder.hpp"
+#include "collectionJournal.hpp"
+#include "depthSorter.hpp"
 #include "fish.hpp"
+#include "snapshotInterpolation.hpp"
 
 #define F_TAG_MAJOR 0
 #define F_TAG_MINOR 3
@@ -37,6 +42,10 @@
 #define F_GAME_FISH_COUNTDOWN_MAX 180
 #define F_GAME_FISH_COUNTDOWN_MIN 30
 
+#define F_PHYSICS_TICK_RATE 60
+#define F_PHYSICS_SUBSTEP_COUNT 4
+#define F_PHYSICS_MAX_STEPS_PER_FRAME 4 // Catch-up cap, the remaining time is dropped when a frame is too long
+
 #define F_MINIGAME_DIFFICULTY_START 0.0f
 #define F_MINIGAME_DIFFICULTY_RARITY_COMMON 10.0f
 #define F_MINIGAME_DIFFICULTY_RARITY_UNCOMMON 20.0f
@@ -61,6 +70,9 @@
 #define F_MINIGAME_HEARTS_COUNT 3
 
 #define F_MINIGAME_WAITING_KEY_TIME 1.5f
+#define F_MINIGAME_KEY_RING_INNER_RADIUS 4.0f
+#define F_MINIGAME_KEY_RING_OUTER_RADIUS 6.4f
+#define F_MINIGAME_KEY_RING_SEGMENTS 64
 
 #define F_COLLECTION_MAX_COL 2
 #define F_COLLECTION_MAX_ROW 3
@@ -78,7 +90,27 @@ public:
     void createWorld();
     [[nodiscard]] b2WorldId getWorld() const;
     void pushStaticCollider(fge::RectFloat const& rect);
-    void updateWorld();
+    //Merge the pushed static colliders and create their single static body, return the merged collider count
+    std::size_t buildStaticColliders();
+    /*
+     * Step the world at a fixed rate.
+     *
+     * The frame time is accumulated and the world is stepped as many times as needed (at most
+     * F_PHYSICS_MAX_STEPS_PER_FRAME), the rendered position of the registered bodies is then interpolated between
+     * the last 2 steps with the remaining time.
+     */
+    void updateWorld(fge::DeltaTime const& deltaTime);
+    void setPhysicsTickRate(unsigned int tickRate);
+    [[nodiscard]] unsigned int getPhysicsTickRate() const;
+    [[nodiscard]] float getPhysicsAlpha() const;
+
+    //Register (or reset after a teleport) a body that is rendered with an interpolated position
+    void registerInterpolatedBody(b2BodyId bodyId);
+    void unregisterInterpolatedBody(b2BodyId bodyId);
+    [[nodiscard]] fge::Vector2f getInterpolatedPosition(b2BodyId bodyId) const;
+
+    [[nodiscard]] DepthSorter& getDepthSorter();
+    [[nodiscard]] SnapshotClock& getSnapshotClock();
 
     [[nodiscard]] Player* getPlayer() const;
     [[nodiscard]] fge::Scene& getScene() const;
@@ -88,8 +120,8 @@ public:
     void pushCaughtFishEvent(std::string const& fishName) const;
     void pushChatEvent(std::string const& chat) const;
 
+    //Load the collection and start its write-behind journal, the collection is saved when the handler is destroyed
     bool loadPlayerCollectionFromFile();
-    void savePlayerCollectionToFile() const;
     [[nodiscard]] FishCollectionData const& getFishPlayerCollection() const;
 
     enum NewRecords : uint8_t
@@ -108,15 +140,65 @@ public:
 
 private:
     b2WorldId g_bworld{};
+    ColliderBuilder g_staticColliders;
+    b2BodyId g_staticBody{};
+
+    struct InterpolatedBody
+    {
+        b2BodyId _bodyId;
+        b2Vec2 _previous;
+        b2Vec2 _current;
+    };
+    std::vector<InterpolatedBody> g_interpolatedBodies;
+    DepthSorter g_depthSorter;
+    SnapshotClock g_snapshotClock;
+    fge::DeltaTime g_physicsAccumulator{0};
+    fge::DeltaTime g_physicsStep{std::chrono::microseconds{1'000'000 / F_PHYSICS_TICK_RATE}};
     fge::DeltaTime g_checkTime{0};
     fge::Scene* g_scene;
     fge::net::ClientSideNetUdp* g_network;
     unsigned int g_fishCountDown = 0;
     FishCollectionData g_fishPlayerCollection;
+    CollectionJournal g_collectionJournal;
 };
 
 extern std::unique_ptr<GameHandler> gGameHandler;
 
+/*
+ * Ring that fills with a progress value.
+ *
+ * The whole ring is built once as a triangle strip (2 vertices per segment step), a progress only changes the
+ * number of drawn vertices so nothing is rasterized or uploaded after the creation.
+ */
+class ProgressRing : public fge::Object
+{
+public:
+    ProgressRing() = default;
+    ~ProgressRing() override = default;
+
+    FGE_OBJ_DRAW_DECLARE
+
+    //The ring starts on the right and fills counterclockwise
+    void create(float innerRadius, float outerRadius, std::size_t segmentCount, fge::Color const& color);
+
+    //Between 0 and 1
+    void setProgress(float progress);
+    [[nodiscard]] float getProgress() const;
+
+    char const* getClassName() const override;
+    char const* getReadableClassName() const override;
+
+    [[nodiscard]] fge::RectFloat getGlobalBounds() const override;
+    [[nodiscard]] fge::RectFloat getLocalBounds() const override;
+
+private:
+    fge::vulkan::VertexBuffer g_vertices{fge::vulkan::GetActiveContext()};
+    std::size_t g_segmentCount = 0;
+    float g_outerRadius = 0.0f;
+    float g_progress = 0.0f;
+    uint32_t g_drawnVertexCount = 0;
+};
+
 class Minigame : public fge::Object
 {
 public:
@@ -159,10 +241,7 @@ private:
     fge::ObjSprite g_fish;
     fge::ObjSprite g_fishTime;
     fge::ObjText g_keyToPress;
-    fge::ObjSprite g_keyToPressCircle;
-    std::shared_ptr<fge::vulkan::TextureImage> g_keyToPressTexture;
-    fge::Surface g_keyToPressSurface;
-    float g_keyToPressAngle = 0.0f;
+    ProgressRing g_keyToPressRing;
     uint32_t g_unicodeKeyToPress = 0;
 
     float g_sliderVelocity = 0.0f;
@@ -222,6 +301,7 @@ public:
     [[nodiscard]] fge::RectFloat getLocalBounds() const override;
 
 private:
+    std::string g_fishName;
     fge::ObjSprite g_fish;
     fge::ObjText g_text;
     float g_currentTime = 0.0f;
@@ -248,14 +328,19 @@ public:
     [[nodiscard]] fge::RectFloat getLocalBounds() const override;
 
 private:
+    void updatePageSprites();
+
     struct FishEntry
     {
-        fge::ObjSprite _sprite;
+        fge::RectInt _textureRect;
+        fge::Vector2f _position;
         fge::ObjText _textName;
         fge::ObjText _textAttributes;
     };
 
     fge::ObjSprite g_book;
+    //All the fishes of the current pages are drawn in one batch from the fish atlas
+    fge::ObjSpriteBatches g_fishSprites;
     fge::DeclareChild<fge::ObjButton> g_buttonNextPage{this};
     fge::DeclareChild<fge::ObjButton> g_buttonLastPage{this};
     fge::DeclareChild<fge::ObjButton> g_buttonClose{this};
@@ -0,0 +1,447 @@
+#include "hierarchicalPathfinder.hpp"
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+namespace
+{
+
+uint32_t ManhattanDistance(fge::Vector2size const& a, fge::Vector2size const& b)
+{
+    auto const dx = a.x > b.x ? a.x - b.x : b.x - a.x;
+    auto const dy = a.y > b.y ? a.y - b.y : b.y - a.y;
+    return static_cast<uint32_t>(dx + dy);
+}
+
+} // namespace
+
+bool HierarchicalPathfinder::build(fge::Vector2size const& size, std::vector<uint8_t> walkable)
+{
+    this->clear();
+
+    if (size.x == 0 || size.y == 0 || walkable.size() != size.x * size.y)
+    {
+        return false;
+    }
+
+    this->g_size = size;
+    this->g_walkable = std::move(walkable);
+    this->g_cellNodes.assign(size.x * size.y, F_HPA_BAD_INDEX);
+
+    this->g_clusterCount = {(size.x + F_HPA_CLUSTER_SIZE - 1) / F_HPA_CLUSTER_SIZE,
+                            (size.y + F_HPA_CLUSTER_SIZE - 1) / F_HPA_CLUSTER_SIZE};
+    this->g_clusters.resize(this->g_clusterCount.x * this->g_clusterCount.y);
+    for (std::size_t y = 0; y < this->g_clusterCount.y; ++y)
+    {
+        for (std::size_t x = 0; x < this->g_clusterCount.x; ++x)
+        {
+            auto& cluster = this->g_clusters[y * this->g_clusterCount.x + x];
+            cluster._position = {x * F_HPA_CLUSTER_SIZE, y * F_HPA_CLUSTER_SIZE};
+            cluster._size = {std::min<std::size_t>(F_HPA_CLUSTER_SIZE, size.x - cluster._position.x),
+                             std::min<std::size_t>(F_HPA_CLUSTER_SIZE, size.y - cluster._position.y)};
+        }
+    }
+
+    this->g_localDistances.resize(F_HPA_CLUSTER_SIZE * F_HPA_CLUSTER_SIZE);
+    this->g_localParents.resize(F_HPA_CLUSTER_SIZE * F_HPA_CLUSTER_SIZE);
+    this->g_localQueue.reserve(F_HPA_CLUSTER_SIZE * F_HPA_CLUSTER_SIZE);
+
+    //Entrances with the right and bottom neighbor clusters
+    for (auto const& cluster: this->g_clusters)
+    {
+        this->addEntrances(cluster, true);
+        this->addEntrances(cluster, false);
+    }
+
+    //Intra cluster edges
+    for (auto& cluster: this->g_clusters)
+    {
+        this->linkClusterNodes(cluster);
+    }
+
+    //Abstract search buffers, the last node is the virtual goal
+    auto const nodeCount = this->g_nodes.size() + 1;
+    this->g_costs.resize(nodeCount);
+    this->g_parents.resize(nodeCount);
+    this->g_goalCosts.resize(nodeCount);
+    this->g_stamps.assign(nodeCount, 0);
+    this->g_goalStamps.assign(nodeCount, 0);
+    this->g_closedStamps.assign(nodeCount, 0);
+    this->g_stamp = 0;
+
+    return true;
+}
+void HierarchicalPathfinder::clear()
+{
+    this->g_size = {0, 0};
+    this->g_walkable.clear();
+    this->g_clusterCount = {0, 0};
+    this->g_clusters.clear();
+    this->g_nodes.clear();
+    this->g_cellNodes.clear();
+}
+
+fge::Vector2size const& HierarchicalPathfinder::getSize() const
+{
+    return this->g_size;
+}
+bool HierarchicalPathfinder::isWalkable(fge::Vector2size const& cell) const
+{
+    return cell.x < this->g_size.x && cell.y < this->g_size.y && this->g_walkable[this->getIndex(cell)] != 0;
+}
+std::size_t HierarchicalPathfinder::getClusterCount() const
+{
+    return this->g_clusters.size();
+}
+std::size_t HierarchicalPathfinder::getNodeCount() const
+{
+    return this->g_nodes.size();
+}
+
+HierarchicalPathfinder::Path HierarchicalPathfinder::findPath(fge::Vector2size const& from, fge::Vector2size const& to)
+{
+    if (!this->isWalkable(from) || !this->isWalkable(to))
+    {
+        return {};
+    }
+
+    Path path{from};
+    if (from == to)
+    {
+        return path;
+    }
+
+    auto const& startCluster = this->g_clusters[this->getClusterIndex(from)];
+    auto const& goalCluster = this->g_clusters[this->getClusterIndex(to)];
+
+    //Same cluster, a local path is enough when it exists (else it may go through other clusters)
+    if (&startCluster == &goalCluster && this->refineLocal(startCluster, from, to, path))
+    {
+        return path;
+    }
+
+    if (++this->g_stamp == 0)
+    { //Stamp overflow, reset everything
+        std::ranges::fill(this->g_stamps, 0);
+        std::ranges::fill(this->g_goalStamps, 0);
+        std::ranges::fill(this->g_closedStamps, 0);
+        this->g_stamp = 1;
+    }
+    auto const stamp = this->g_stamp;
+    auto const goalNode = static_cast<uint32_t>(this->g_nodes.size());
+
+    //Connect the goal to the nodes of its cluster
+    this->searchLocal(goalCluster, to);
+    for (auto const node: goalCluster._nodes)
+    {
+        auto const distance = this->getLocalDistance(goalCluster, this->g_nodes[node]._cell);
+        if (distance != F_HPA_BAD_INDEX)
+        {
+            this->g_goalCosts[node] = distance;
+            this->g_goalStamps[node] = stamp;
+        }
+    }
+
+    using OpenEntry = std::pair<uint32_t, uint32_t>; //(estimated cost, node)
+    std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<>> open;
+
+    auto const relax = [&](uint32_t node, uint32_t cost, uint32_t parent) {
+        if (this->g_closedStamps[node] == stamp || (this->g_stamps[node] == stamp && this->g_costs[node] <= cost))
+        {
+            return;
+        }
+        this->g_stamps[node] = stamp;
+        this->g_costs[node] = cost;
+        this->g_parents[node] = parent;
+
+        auto const heuristic = node == goalNode ? 0 : ManhattanDistance(this->g_nodes[node]._cell, to);
+        open.emplace(cost + heuristic, node);
+    };
+
+    //Connect the start to the nodes of its cluster
+    this->searchLocal(startCluster, from);
+    for (auto const node: startCluster._nodes)
+    {
+        auto const distance = this->getLocalDistance(startCluster, this->g_nodes[node]._cell);
+        if (distance != F_HPA_BAD_INDEX)
+        {
+            relax(node, distance, F_HPA_BAD_INDEX);
+        }
+    }
+
+    //Abstract A*
+    bool found = false;
+    while (!open.empty())
+    {
+        auto const node = open.top().second;
+        open.pop();
+
+        if (this->g_closedStamps[node] == stamp)
+        {
+            continue;
+        }
+        this->g_closedStamps[node] = stamp;
+
+        if (node == goalNode)
+        {
+            found = true;
+            break;
+        }
+
+        auto const cost = this->g_costs[node];
+        for (auto const& edge: this->g_nodes[node]._edges)
+        {
+            relax(edge._to, cost + edge._cost, node);
+        }
+        if (this->g_goalStamps[node] == stamp)
+        {
+            relax(goalNode, cost + this->g_goalCosts[node], node);
+        }
+    }
+
+    if (!found)
+    {
+        return {};
+    }
+
+    //Abstract path, from the start to the goal
+    std::vector<uint32_t> abstractPath;
+    for (auto node = this->g_parents[goalNode]; node != F_HPA_BAD_INDEX; node = this->g_parents[node])
+    {
+        abstractPath.push_back(node);
+    }
+    std::ranges::reverse(abstractPath);
+
+    //Refine every step
+    auto current = from;
+    auto const refineTo = [&](fge::Vector2size const& cell) {
+        if (current == cell)
+        {
+            return true;
+        }
+        if (ManhattanDistance(current, cell) == 1)
+        { //Transition between 2 clusters
+            path.push_back(cell);
+        }
+        else if (!this->refineLocal(this->g_clusters[this->getClusterIndex(current)], current, cell, path))
+        {
+            return false;
+        }
+        current = cell;
+        return true;
+    };
+
+    for (auto const node: abstractPath)
+    {
+        if (!refineTo(this->g_nodes[node]._cell))
+        {
+            return {};
+        }
+    }
+    if (!refineTo(to))
+    {
+        return {};
+    }
+
+    return path;
+}
+
+std::size_t HierarchicalPathfinder::getIndex(fge::Vector2size const& cell) const
+{
+    return cell.y * this->g_size.x + cell.x;
+}
+uint32_t HierarchicalPathfinder::getClusterIndex(fge::Vector2size const& cell) const
+{
+    return static_cast<uint32_t>((cell.y / F_HPA_CLUSTER_SIZE) * this->g_clusterCount.x +
+                                 cell.x / F_HPA_CLUSTER_SIZE);
+}
+
+uint32_t HierarchicalPathfinder::addNode(fge::Vector2size const& cell)
+{
+    auto& cellNode = this->g_cellNodes[this->getIndex(cell)];
+    if (cellNode != F_HPA_BAD_INDEX)
+    {
+        return cellNode;
+    }
+
+    cellNode = static_cast<uint32_t>(this->g_nodes.size());
+    auto const clusterIndex = this->getClusterIndex(cell);
+    this->g_nodes.push_back({cell, clusterIndex, {}});
+    this->g_clusters[clusterIndex]._nodes.push_back(cellNode);
+    return cellNode;
+}
+void HierarchicalPathfinder::addTransition(fge::Vector2size const& cellA, fge::Vector2size const& cellB)
+{
+    auto const nodeA = this->addNode(cellA);
+    auto const nodeB = this->addNode(cellB);
+    this->g_nodes[nodeA]._edges.push_back({nodeB, 1});
+    this->g_nodes[nodeB]._edges.push_back({nodeA, 1});
+}
+void HierarchicalPathfinder::addEntrances(Cluster const& cluster, bool right)
+{
+    //The border cells of this cluster and the ones of the neighbor cluster
+    fge::Vector2size border;
+    fge::Vector2size step;
+    fge::Vector2size offset;
+    std::size_t length;
+    if (right)
+    {
+        if (cluster._position.x + cluster._size.x >= this->g_size.x)
+        {
+            return;
+        }
+        border = {cluster._position.x + cluster._size.x - 1, cluster._position.y};
+        step = {0, 1};
+        offset = {1, 0};
+        length = cluster._size.y;
+    }
+    else
+    {
+        if (cluster._position.y + cluster._size.y >= this->g_size.y)
+        {
+            return;
+        }
+        border = {cluster._position.x, cluster._position.y + cluster._size.y - 1};
+        step = {1, 0};
+        offset = {0, 1};
+        length = cluster._size.x;
+    }
+
+    auto const closeEntrance = [&](std::size_t start, std::size_t end) {
+        auto const entranceLength = end - start;
+        if (entranceLength >= F_HPA_ENTRANCE_SPLIT_LENGTH)
+        {
+            auto const first = border + step * start;
+            auto const last = border + step * (end - 1);
+            this->addTransition(first, first + offset);
+            this->addTransition(last, last + offset);
+        }
+        else
+        {
+            auto const middle = border + step * (start + entranceLength / 2);
+            this->addTransition(middle, middle + offset);
+        }
+    };
+
+    std::optional<std::size_t> entranceStart;
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        auto const cell = border + step * i;
+        bool const open = this->isWalkable(cell) && this->isWalkable(cell + offset);
+        if (open && !entranceStart)
+        {
+            entranceStart = i;
+        }
+        else if (!open && entranceStart)
+        {
+            closeEntrance(*entranceStart, i);
+            entranceStart.reset();
+        }
+    }
+    if (entranceStart)
+    {
+        closeEntrance(*entranceStart, length);
+    }
+}
+void HierarchicalPathfinder::linkClusterNodes(Cluster& cluster)
+{
+    for (std::size_t a = 0; a < cluster._nodes.size(); ++a)
+    {
+        auto const nodeA = cluster._nodes[a];
+        this->searchLocal(cluster, this->g_nodes[nodeA]._cell);
+
+        for (std::size_t b = a + 1; b < cluster._nodes.size(); ++b)
+        {
+            auto const nodeB = cluster._nodes[b];
+            auto const distance = this->getLocalDistance(cluster, this->g_nodes[nodeB]._cell);
+            if (distance != F_HPA_BAD_INDEX)
+            {
+                this->g_nodes[nodeA]._edges.push_back({nodeB, distance});
+                this->g_nodes[nodeB]._edges.push_back({nodeA, distance});
+            }
+        }
+    }
+}
+
+void HierarchicalPathfinder::searchLocal(Cluster const& cluster,
+                                         fge::Vector2size const& from,
+                                         std::optional<fge::Vector2size> const& target)
+{
+    auto const localIndex = [&](fge::Vector2size const& cell) {
+        return static_cast<uint32_t>((cell.y - cluster._position.y) * F_HPA_CLUSTER_SIZE +
+                                     (cell.x - cluster._position.x));
+    };
+    auto const localCell = [&](uint32_t index) {
+        return fge::Vector2size{cluster._position.x + index % F_HPA_CLUSTER_SIZE,
+                                cluster._position.y + index / F_HPA_CLUSTER_SIZE};
+    };
+
+    std::ranges::fill(this->g_localDistances, F_HPA_BAD_INDEX);
+    this->g_localQueue.clear();
+
+    auto const fromIndex = localIndex(from);
+    this->g_localDistances[fromIndex] = 0;
+    this->g_localParents[fromIndex] = F_HPA_BAD_INDEX;
+    this->g_localQueue.push_back(fromIndex);
+
+    for (std::size_t i = 0; i < this->g_localQueue.size(); ++i)
+    {
+        auto const index = this->g_localQueue[i];
+        auto const cell = localCell(index);
+        if (target && cell == *target)
+        {
+            return;
+        }
+
+        auto const distance = this->g_localDistances[index];
+        auto const visit = [&](fge::Vector2size const& neighbor) {
+            if (neighbor.x < cluster._position.x || neighbor.y < cluster._position.y ||
+                neighbor.x >= cluster._position.x + cluster._size.x ||
+                neighbor.y >= cluster._position.y + cluster._size.y || !this->isWalkable(neighbor))
+            {
+                return;
+            }
+            auto const neighborIndex = localIndex(neighbor);
+            if (this->g_localDistances[neighborIndex] != F_HPA_BAD_INDEX)
+            {
+                return;
+            }
+            this->g_localDistances[neighborIndex] = distance + 1;
+            this->g_localParents[neighborIndex] = index;
+            this->g_localQueue.push_back(neighborIndex);
+        };
+
+        //Unsigned wrap for the left/up neighbors is caught by the bounds check
+        visit({cell.x - 1, cell.y});
+        visit({cell.x + 1, cell.y});
+        visit({cell.x, cell.y - 1});
+        visit({cell.x, cell.y + 1});
+    }
+}
+uint32_t HierarchicalPathfinder::getLocalDistance(Cluster const& cluster, fge::Vector2size const& cell) const
+{
+    return this->g_localDistances[(cell.y - cluster._position.y) * F_HPA_CLUSTER_SIZE +
+                                  (cell.x - cluster._position.x)];
+}
+bool HierarchicalPathfinder::refineLocal(Cluster const& cluster,
+                                         fge::Vector2size const& from,
+                                         fge::Vector2size const& to,
+                                         Path& path)
+{
+    this->searchLocal(cluster, from, to);
+    if (this->getLocalDistance(cluster, to) == F_HPA_BAD_INDEX)
+    {
+        return false;
+    }
+
+    auto const pathStart = path.size();
+    for (auto index = static_cast<uint32_t>((to.y - cluster._position.y) * F_HPA_CLUSTER_SIZE +
+                                            (to.x - cluster._position.x));
+         this->g_localParents[index] != F_HPA_BAD_INDEX; index = this->g_localParents[index])
+    {
+        path.push_back({cluster._position.x + index % F_HPA_CLUSTER_SIZE,
+                        cluster._position.y + index / F_HPA_CLUSTER_SIZE});
+    }
+    std::reverse(path.begin() + static_cast<std::ptrdiff_t>(pathStart), path.end());
+    return true;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "FastEngine/C_vector.hpp"
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#define F_HPA_CLUSTER_SIZE 16
+#define F_HPA_ENTRANCE_SPLIT_LENGTH 6 // Entrances at least this long get a transition at both ends
+#define F_HPA_BAD_INDEX 0xFFFFFFFF
+
+/*
+ * Hierarchical path finding (HPA*) on a 4-connected walkability grid.
+ *
+ * The grid is cut into square clusters, every border run walkable on both sides is an entrance with one or two
+ * transitions (a pair of abstract nodes, one in each cluster). Abstract nodes of the same cluster are linked with
+ * their local distance, so a query is an A* on the small abstract graph followed by a local search inside each
+ * crossed cluster to refine the path.
+ *
+ * Paths are close to optimal (they go through the transitions), the queries are not thread-safe as they use
+ * internal scratch buffers.
+ */
+class HierarchicalPathfinder
+{
+public:
+    using Path = std::vector<fge::Vector2size>;
+
+    HierarchicalPathfinder() = default;
+
+    //One byte per cell in row major order, non zero is walkable
+    bool build(fge::Vector2size const& size, std::vector<uint8_t> walkable);
+    void clear();
+
+    [[nodiscard]] fge::Vector2size const& getSize() const;
+    [[nodiscard]] bool isWalkable(fge::Vector2size const& cell) const;
+    [[nodiscard]] std::size_t getClusterCount() const;
+    [[nodiscard]] std::size_t getNodeCount() const;
+
+    //Path from the start cell to the goal cell (both included), empty if there is none
+    [[nodiscard]] Path findPath(fge::Vector2size const& from, fge::Vector2size const& to);
+
+private:
+    struct Edge
+    {
+        uint32_t _to;
+        uint32_t _cost;
+    };
+    struct Node
+    {
+        fge::Vector2size _cell;
+        uint32_t _cluster;
+        std::vector<Edge> _edges;
+    };
+    struct Cluster
+    {
+        fge::Vector2size _position;
+        fge::Vector2size _size;
+        std::vector<uint32_t> _nodes;
+    };
+
+    [[nodiscard]] std::size_t getIndex(fge::Vector2size const& cell) const;
+    [[nodiscard]] uint32_t getClusterIndex(fge::Vector2size const& cell) const;
+
+    uint32_t addNode(fge::Vector2size const& cell);
+    void addTransition(fge::Vector2size const& cellA, fge::Vector2size const& cellB);
+    void addEntrances(Cluster const& cluster, bool right);
+    void linkClusterNodes(Cluster& cluster);
+
+    //Breadth first search limited to the cluster, distances are then read with getLocalDistance()
+    void searchLocal(Cluster const& cluster,
+                     fge::Vector2size const& from,
+                     std::optional<fge::Vector2size> const& target = std::nullopt);
+    [[nodiscard]] uint32_t getLocalDistance(Cluster const& cluster, fge::Vector2size const& cell) const;
+    //Append the local path (without from) to the path
+    bool refineLocal(Cluster const& cluster, fge::Vector2size const& from, fge::Vector2size const& to, Path& path);
+
+    fge::Vector2size g_size{0, 0};
+    std::vector<uint8_t> g_walkable;
+    fge::Vector2size g_clusterCount{0, 0};
+    std::vector<Cluster> g_clusters;
+    std::vector<Node> g_nodes;
+    std::vector<uint32_t> g_cellNodes;
+
+    //Scratch buffers
+    std::vector<uint32_t> g_localDistances;
+    std::vector<uint32_t> g_localParents;
+    std::vector<uint32_t> g_localQueue;
+
+    std::vector<uint32_t> g_costs;
+    std::vector<uint32_t> g_parents;
+    std::vector<uint32_t> g_goalCosts;
+    std::vector<uint32_t> g_stamps;
+    std::vector<uint32_t> g_goalStamps;
+    std::vector<uint32_t> g_closedStamps;
+    uint32_t g_stamp{0};
+};
@@ -11,18 +11,32 @@
 
 #include "../share/network.hpp"
 #include "../share/player.hpp"
-#include "ducky.hpp"
+#include "assetLoader.hpp"
+#include "duckFlock.hpp"
+#include "entityBatch.hpp"
 #include "fish.hpp"
+#include "frameTiming.hpp"
 #include "game.hpp"
-
+#include "mapCache.hpp"
+#include "navigation.hpp"
+#include "networkThread.hpp"
+#include "pathfindingService.hpp"
+#include "textureAtlas.hpp"
+
+#include <algorithm>
+#include <future>
 #include <iostream>
 #include <memory>
 
 #define BAD_PACKET_LIMIT 10
 #define RETURN_PACKET_DELAYms 100
+#define RECONNECT_DELAYms 5000
 
 #define SHOW_COLLIDERS 0
 
+#define F_MAP_FILE "resources/map_1/map_1.json"
+#define F_MAP_CACHE_FILE "resources/map_1/map_1" F_MAP_CACHE_EXTENSION
+
 std::atomic_bool gAskForFullUpdate = false;
 
 class Scene : public fge::Scene
@@ -30,7 +44,9 @@ class Scene : public fge::Scene
 public:
     ~Scene() override = default;
 
-    void run(fge::RenderWindow& renderWindow, fge::net::ClientSideNetUdp& network)
+    void run(fge::RenderWindow& renderWindow,
+             fge::net::ClientSideNetUdp& network,
+             GraphicsConfig const& graphicsConfig)
     {
         nlohmann::json config;
         if (!fge::LoadJsonFromFile("server.json", config))
@@ -42,9 +58,10 @@ public:
         fge::net::Port serverPort = config.value<fge::net::Port>("port", F_NET_DEFAULT_PORT);
         bool onlineMode = config.value<bool>("online", F_NET_DEFAULT_ONLINE_MODE);
 
-        config = nlohmann::json{{"ip", serverIp.toString().value_or(F_NET_DEFAULT_IP)},
-                                {"port", serverPort},
-                                {"online", onlineMode}};
+        //The other settings (like the server "shards") are kept, the server redirects the clients to its shards
+        config["ip"] = serverIp.toString().value_or(F_NET_DEFAULT_IP);
+        config["port"] = serverPort;
+        config["online"] = onlineMode;
 
         if (!fge::SaveJsonToFile("server.json", config, 4))
         {
@@ -63,6 +80,7 @@ public:
         guiElementHandler.setEventCallback();
 
         uint16_t badPacketUpdatesCount = 0;
+        NetworkThread networkThread;
 
         this->setCallbackContext({&event, &guiElementHandler});
         this->setLinkedRenderTarget(&renderWindow);
@@ -91,119 +109,126 @@ public:
                 FGE_OBJSPRITEBATCHES_SHADER_VERTEX, "resources/shaders/objSpriteBatches_vertex.vert",
                 fge::vulkan::Shader::Type::SHADER_VERTEX, fge::shader::ShaderInputTypes::SHADER_GLSL);
 
-        //Load textures
-        fge::texture::gManager.loadFromFile("OutdoorsTileset", "resources/tilesets/OutdoorsTileset.png");
-        fge::texture::gManager.loadFromFile("fishBait_1", "resources/sprites/fishBait_1.png");
-        fge::texture::gManager.loadFromFile("fishingFrame", "resources/sprites/fishingFrame.png");
-        fge::texture::gManager.loadFromFile("fishingIcon", "resources/sprites/fishingIcon.png");
-        fge::texture::gManager.loadFromFile("fishTime", "resources/sprites/fishTime.png");
-        fge::texture::gManager.loadFromFile("stars", "resources/sprites/stars.png");
-        fge::texture::gManager.loadFromFile("hearts", "resources/sprites/hearts.png");
-        fge::texture::gManager.loadFromFile("book_1", "resources/sprites/book_1.png");
-        fge::texture::gManager.loadFromFile("book_3", "resources/sprites/book_3.png");
-        fge::texture::gManager.loadFromFile("arrows", "resources/sprites/arrows.png");
-        fge::texture::gManager.loadFromFile("close_1", "resources/sprites/close_1.png");
+        //Load textures, everything that is not needed for the first frame is loaded while playing
+        using enum AssetLoader::Groups;
+        gAssetLoader.pushTexture("OutdoorsTileset", "resources/tilesets/OutdoorsTileset.png", STARTUP);
+        gAssetLoader.pushTexture("fishBait_1", "resources/sprites/fishBait_1.png", STARTUP);
+        gAssetLoader.pushTexture("book_3", "resources/sprites/book_3.png", STARTUP);
+        gAssetLoader.pushTexture("fishingFrame", "resources/sprites/fishingFrame.png", DEFERRED);
+        gAssetLoader.pushTexture("fishingIcon", "resources/sprites/fishingIcon.png", DEFERRED);
+        gAssetLoader.pushTexture("fishTime", "resources/sprites/fishTime.png", DEFERRED);
+        gAssetLoader.pushTexture("stars", "resources/sprites/stars.png", DEFERRED);
+        gAssetLoader.pushTexture("hearts", "resources/sprites/hearts.png", DEFERRED);
+        gAssetLoader.pushAtlas(gCollectionAtlas,
+                               {{"book_1", "resources/sprites/book_1.png"},
+                                {"arrows", "resources/sprites/arrows.png"},
+                                {"close_1", "resources/sprites/close_1.png"}},
+                               DEFERRED);
 
         //Load animations
         fge::anim::gManager.loadFromFile("human_1", "resources/sprites/human_1.json");
-        fge::anim::gManager.loadFromFile("ducky_1", "resources/sprites/ducky_1.json");
+        fge::anim::gManager.loadFromFile(F_DUCK_FLOCK_ANIMATION, "resources/sprites/ducky_1.json");
+        //The entity batches draw the animations with their tileset texture
+        AssetLoader::ShareAnimationTexture("human_1");
+        AssetLoader::ShareAnimationTexture(F_DUCK_FLOCK_ANIMATION);
 
-        //Create player shadow
-        {
-            fge::anim::gManager.duplicate("human_1", "human_1_shadow");
-            auto humanAnimData = fge::anim::gManager.getElement("human_1_shadow");
+        //Load fonts
+        fge::font::gManager.loadFromFile("default", "resources/fonts/ttf/monogram.ttf");
 
-            fge::Surface surface(humanAnimData->_ptr->_tilesetTexture->copyToSurface());
-            for (int i = 0; i < surface.getSize().x; ++i)
+        //Load sounds
+        gAssetLoader.pushAudio("loose_life", "resources/audio/negative_1.ogg", DEFERRED);
+        gAssetLoader.pushAudio("loose_fish", "resources/audio/negative_2.ogg", DEFERRED);
+        gAssetLoader.pushAudio("walk_grass", "resources/audio/walk_grass_1.ogg", DEFERRED, []() {
+            Mix_VolumeChunk(fge::audio::gManager.getElement("walk_grass")->_ptr.get(), MIX_MAX_VOLUME);
+        });
+        gAssetLoader.pushAudio("swipe", "resources/audio/swipe_1.ogg", DEFERRED);
+        gAssetLoader.pushAudio("splash", "resources/audio/splash_1.ogg", DEFERRED);
+        gAssetLoader.pushAudio("victory_fish", "resources/audio/positive_1.ogg", DEFERRED);
+        gAssetLoader.pushAudio("ducky", "resources/audio/duck_1.ogg", DEFERRED);
+        gAssetLoader.pushAudio("jingle", "resources/audio/jingle_1.ogg", DEFERRED);
+        gAssetLoader.pushAudio("fish_is_here", "resources/audio/fish_is_here_1.ogg", DEFERRED);
+
+        //Load fishes, they are packed in one atlas and registered once it is uploaded
+        struct FishDefinition
+        {
+            std::string _name;
+            float _weightMin;
+            float _weightMax;
+            float _lengthMin;
+            float _lengthMax;
+            FishData::Rarity _rarity;
+        };
+        auto fishDefinitions = std::make_shared<std::vector<FishDefinition>>();
+        std::vector<TextureAtlas::Sprite> fishSprites;
+        auto const loadFish = [&](std::string const& fishName, float weightMin, float weightMax, float lengthMin,
+                                  float lengthMax, FishData::Rarity rarity, std::filesystem::path const& path) {
+            fishDefinitions->push_back({fishName, weightMin, weightMax, lengthMin, lengthMax, rarity});
+            fishSprites.push_back({fishName, path});
+        };
+        loadFish("algae", 10.0f, 50.0f, 1.0f, 5.0f, FishData::Rarity::COMMON, "resources/sprites/fishes/algae.png");
+        loadFish("anchovy", 20.0f, 100.0f, 2.0f, 8.0f, FishData::Rarity::COMMON,
+                 "resources/sprites/fishes/fish-anchovy.png");
+        loadFish("butter", 50.0f, 200.0f, 3.0f, 12.0f, FishData::Rarity::COMMON,
+                 "resources/sprites/fishes/fish-butter.png");
+        loadFish("gulf-croaker", 80.0f, 300.0f, 4.0f, 15.0f, FishData::Rarity::COMMON,
+                 "resources/sprites/fishes/fish-gulf-croaker.png");
+        loadFish("halfbeak", 30.0f, 120.0f, 2.5f, 10.0f, FishData::Rarity::COMMON,
+                 "resources/sprites/fishes/fish-halfbeak.png");
+        loadFish("herring", 40.0f, 150.0f, 3.0f, 11.0f, FishData::Rarity::COMMON,
+                 "resources/sprites/fishes/fish-herring.png");
+        loadFish("sandlance", 10.0f, 70.0f, 1.5f, 7.0f, FishData::Rarity::COMMON,
+                 "resources/sprites/fishes/fish-sandlance.png");
+        loadFish("sardine", 20.0f, 90.0f, 2.0f, 9.0f, FishData::Rarity::COMMON,
+                 "resources/sprites/fishes/fish-sardine.png");
+        loadFish("shrimp-anemone", 5.0f, 20.0f, 0.5f, 2.0f, FishData::Rarity::COMMON,
+                 "resources/sprites/fishes/shrimp-anemone.png");
+        loadFish("shrimp-northern-prawn", 10.0f, 40.0f, 1.0f, 3.0f, FishData::Rarity::COMMON,
+                 "resources/sprites/fishes/shrimp-northern-prawn.png");
+        loadFish("krill", 1.0f, 5.0f, 0.8f, 5.0f, FishData::Rarity::COMMON, "resources/sprites/fishes/krill.png");
+        loadFish("krill-1", 1.0f, 5.0f, 0.2f, 6.0f, FishData::Rarity::COMMON, "resources/sprites/fishes/krill-1.png");
+
+        loadFish("pollock", 200.0f, 1000.0f, 10.0f, 40.0f, FishData::Rarity::UNCOMMON,
+                 "resources/sprites/fishes/fish-pollock.png");
+        loadFish("bronze-striped-grunt", 100.0f, 500.0f, 5.0f, 20.0f, FishData::Rarity::UNCOMMON,
+                 "resources/sprites/fishes/fish-bronze-striped-grunt.png");
+        loadFish("krill-2", 1.0f, 5.0f, 1.0f, 10.0f, FishData::Rarity::UNCOMMON,
+                 "resources/sprites/fishes/krill-2.png");
+        loadFish("zoo-plankton", 0.5f, 2.0f, 0.1f, 0.5f, FishData::Rarity::UNCOMMON,
+                 "resources/sprites/fishes/zoo-plankton.png");
+        loadFish("zoo-plankton-small", 0.2f, 1.0f, 0.05f, 0.3f, FishData::Rarity::UNCOMMON,
+                 "resources/sprites/fishes/zoo-plankton-small.png");
+
+        loadFish("krill-3", 1.0f, 5.0f, 0.2f, 1.2f, FishData::Rarity::RARE, "resources/sprites/fishes/krill-3.png");
+        loadFish("squid-reef", 100.0f, 500.0f, 5.0f, 20.0f, FishData::Rarity::RARE,
+                 "resources/sprites/fishes/squid-reef.png");
+        loadFish("bubble-eyes", 110.0f, 170.0f, 12.0f, 30.0f, FishData::Rarity::RARE,
+                 "resources/sprites/fishes/bubble-eyes.png");
+        loadFish("duck-fish", 500.0f, 1600.0f, 30.0f, 70.0f, FishData::Rarity::RARE,
+                 "resources/sprites/fishes/duck-fish.png");
+
+        gAssetLoader.pushAtlas(gFishAtlas, std::move(fishSprites), DEFERRED, [fishDefinitions]() {
+            for (auto const& fish: *fishDefinitions)
             {
-                for (int j = 0; j < surface.getSize().y; ++j)
-                {
-                    auto color = fge::Color(0, 0, 0, surface.getPixel(i, j).value()._a);
-                    surface.setPixel(i, j, color);
-                }
+                gFishManager.loadFromTexture(fish._name, fish._weightMin, fish._weightMax, fish._lengthMin,
+                                             fish._lengthMax, fish._rarity, gFishAtlas.getName(),
+                                             gFishAtlas.getRect(fish._name));
             }
-            humanAnimData->_ptr->_tilesetTexture = std::make_shared<fge::TextureType>(fge::vulkan::GetActiveContext());
-            humanAnimData->_ptr->_tilesetTexture->create(surface.get());
-        }
+            gFishManager.freeze();
+        });
 
-        //Create ducky shadow
+        gAssetLoader.start();
+        if (!this->runLoadingScreen(renderWindow, event))
         {
-            fge::anim::gManager.duplicate("ducky_1", "ducky_1_shadow");
-            auto duckyAnimData = fge::anim::gManager.getElement("ducky_1_shadow");
-
-            fge::Surface surface(duckyAnimData->_ptr->_tilesetTexture->copyToSurface());
-            for (int i = 0; i < surface.getSize().x; ++i)
-            {
-                for (int j = 0; j < surface.getSize().y; ++j)
-                {
-                    auto color = fge::Color(0, 0, 0, surface.getPixel(i, j).value()._a);
-                    surface.setPixel(i, j, color);
-                }
-            }
-            duckyAnimData->_ptr->_tilesetTexture = std::make_shared<fge::TextureType>(fge::vulkan::GetActiveContext());
-            duckyAnimData->_ptr->_tilesetTexture->create(surface.get());
-        }
+            gAssetLoader.stop();
 
-        //Load fonts
-        fge::font::gManager.loadFromFile("default", "resources/fonts/ttf/monogram.ttf");
+            fge::texture::gManager.uninitialize();
+            fge::font::gManager.uninitialize();
+            fge::shader::gManager.uninitialize();
+            fge::anim::gManager.uninitialize();
 
-        //Load sounds
-        fge::audio::gManager.loadFromFile("loose_life", "resources/audio/negative_1.ogg");
-        fge::audio::gManager.loadFromFile("loose_fish", "resources/audio/negative_2.ogg");
-        fge::audio::gManager.loadFromFile("walk_grass", "resources/audio/walk_grass_1.ogg");
-        Mix_VolumeChunk(fge::audio::gManager.getElement("walk_grass")->_ptr.get(), MIX_MAX_VOLUME);
-        fge::audio::gManager.loadFromFile("swipe", "resources/audio/swipe_1.ogg");
-        fge::audio::gManager.loadFromFile("splash", "resources/audio/splash_1.ogg");
-        fge::audio::gManager.loadFromFile("victory_fish", "resources/audio/positive_1.ogg");
-        fge::audio::gManager.loadFromFile("ducky", "resources/audio/duck_1.ogg");
-        fge::audio::gManager.loadFromFile("jingle", "resources/audio/jingle_1.ogg");
-        fge::audio::gManager.loadFromFile("fish_is_here", "resources/audio/fish_is_here_1.ogg");
-
-        //Load fishes
-        gFishManager.loadFromFile("algae", 10.0f, 50.0f, 1.0f, 5.0f, FishData::Rarity::COMMON,
-                                  "resources/sprites/fishes/algae.png");
-        gFishManager.loadFromFile("anchovy", 20.0f, 100.0f, 2.0f, 8.0f, FishData::Rarity::COMMON,
-                                  "resources/sprites/fishes/fish-anchovy.png");
-        gFishManager.loadFromFile("butter", 50.0f, 200.0f, 3.0f, 12.0f, FishData::Rarity::COMMON,
-                                  "resources/sprites/fishes/fish-butter.png");
-        gFishManager.loadFromFile("gulf-croaker", 80.0f, 300.0f, 4.0f, 15.0f, FishData::Rarity::COMMON,
-                                  "resources/sprites/fishes/fish-gulf-croaker.png");
-        gFishManager.loadFromFile("halfbeak", 30.0f, 120.0f, 2.5f, 10.0f, FishData::Rarity::COMMON,
-                                  "resources/sprites/fishes/fish-halfbeak.png");
-        gFishManager.loadFromFile("herring", 40.0f, 150.0f, 3.0f, 11.0f, FishData::Rarity::COMMON,
-                                  "resources/sprites/fishes/fish-herring.png");
-        gFishManager.loadFromFile("sandlance", 10.0f, 70.0f, 1.5f, 7.0f, FishData::Rarity::COMMON,
-                                  "resources/sprites/fishes/fish-sandlance.png");
-        gFishManager.loadFromFile("sardine", 20.0f, 90.0f, 2.0f, 9.0f, FishData::Rarity::COMMON,
-                                  "resources/sprites/fishes/fish-sardine.png");
-        gFishManager.loadFromFile("shrimp-anemone", 5.0f, 20.0f, 0.5f, 2.0f, FishData::Rarity::COMMON,
-                                  "resources/sprites/fishes/shrimp-anemone.png");
-        gFishManager.loadFromFile("shrimp-northern-prawn", 10.0f, 40.0f, 1.0f, 3.0f, FishData::Rarity::COMMON,
-                                  "resources/sprites/fishes/shrimp-northern-prawn.png");
-        gFishManager.loadFromFile("krill", 1.0f, 5.0f, 0.8f, 5.0f, FishData::Rarity::COMMON,
-                                  "resources/sprites/fishes/krill.png");
-        gFishManager.loadFromFile("krill-1", 1.0f, 5.0f, 0.2f, 6.0f, FishData::Rarity::COMMON,
-                                  "resources/sprites/fishes/krill-1.png");
-
-        gFishManager.loadFromFile("pollock", 200.0f, 1000.0f, 10.0f, 40.0f, FishData::Rarity::UNCOMMON,
-                                  "resources/sprites/fishes/fish-pollock.png");
-        gFishManager.loadFromFile("bronze-striped-grunt", 100.0f, 500.0f, 5.0f, 20.0f, FishData::Rarity::UNCOMMON,
-                                  "resources/sprites/fishes/fish-bronze-striped-grunt.png");
-        gFishManager.loadFromFile("krill-2", 1.0f, 5.0f, 1.0f, 10.0f, FishData::Rarity::UNCOMMON,
-                                  "resources/sprites/fishes/krill-2.png");
-        gFishManager.loadFromFile("zoo-plankton", 0.5f, 2.0f, 0.1f, 0.5f, FishData::Rarity::UNCOMMON,
-                                  "resources/sprites/fishes/zoo-plankton.png");
-        gFishManager.loadFromFile("zoo-plankton-small", 0.2f, 1.0f, 0.05f, 0.3f, FishData::Rarity::UNCOMMON,
-                                  "resources/sprites/fishes/zoo-plankton-small.png");
-
-        gFishManager.loadFromFile("krill-3", 1.0f, 5.0f, 0.2f, 1.2f, FishData::Rarity::RARE,
-                                  "resources/sprites/fishes/krill-3.png");
-        gFishManager.loadFromFile("squid-reef", 100.0f, 500.0f, 5.0f, 20.0f, FishData::Rarity::RARE,
-                                  "resources/sprites/fishes/squid-reef.png");
-        gFishManager.loadFromFile("bubble-eyes", 110.0f, 170.0f, 12.0f, 30.0f, FishData::Rarity::RARE,
-                                  "resources/sprites/fishes/bubble-eyes.png");
-        gFishManager.loadFromFile("duck-fish", 500.0f, 1600.0f, 30.0f, 70.0f, FishData::Rarity::RARE,
-                                  "resources/sprites/fishes/duck-fish.png");
+            gGameHandler.reset();
+            return;
+        }
 
         //Prepare the view
         auto view = renderWindow.getView();
@@ -219,6 +244,10 @@ public:
 
         this->newObject<FishCollectionIcon>({FGE_SCENE_PLAN_HIGH_TOP});
 
+        auto* objFrameTimeOverlay = this->newObject<FrameTimeOverlay>({FGE_SCENE_PLAN_HIGH_TOP + 10});
+        objFrameTimeOverlay->_tags.add("frameTimeOverlay");
+        objFrameTimeOverlay->setVisible(graphicsConfig._showFrameTimeOverlay);
+
         // Create a tileMap object
         auto tilemap = fge::TileMap::create();
 
@@ -226,42 +255,43 @@ public:
         std::vector<fge::ObjRectangleShape*> objRectCollider;
 #endif
 
-        //Load the tileMap from a "tiled" json
-        tilemap->loadFromFile("resources/map_1/map_1.json");
+        //Load the tileMap from a "tiled" json, only for the rendering and the special objects (the map cache is not
+        //validated with the json content, so this is the only parse of the map)
+        tilemap->loadFromFile(F_MAP_FILE);
         tilemap->generateObjects(*this, FGE_SCENE_PLAN_HIDE_BACK - 10);
         tilemap->_generatedObjects.front().lock()->getObject()->_tags.add(
                 "map"); //Add tag to the first tile layer object, in order to find it later
 
-        for (auto const& layer: tilemap->_layers)
+        //Colliders, water, walkability and depth lines are read from the baked map
+        if (!gMapCache.loadOrBake(*tilemap, F_MAP_FILE, F_MAP_CACHE_FILE))
         {
-            if (layer->getType() != fge::BaseLayer::Types::TILE_LAYER)
-            {
-                continue;
-            }
+            std::cout << "Can't load the map cache\n";
+        }
+        else
+        {
+            gGameHandler->getDepthSorter().setDepthLines(gMapCache.getDepthLines());
+            gNavigation.build(gMapCache);
+            gPathfindingService.start(gNavigation);
+        }
+        gGameHandler->getDepthSorter().setDepthPlan(
+                tilemap->retrieveGeneratedTilelayerObject(F_MAP_LAYER_DEPTH_OBJECTS)->getPlan());
 
-            for (auto const& tile: layer->as<fge::TileLayer>()->getTiles())
-            {
-                if (tile.getGid() == 0)
-                {
-                    continue;
-                }
-                auto const& collisions = tile.getTileData()->_collisionRects;
-                for (auto const& collision: collisions)
-                {
-                    auto collisionRect = static_cast<fge::RectFloat>(collision);
-                    collisionRect._x += tile.getPosition().x;
-                    collisionRect._y += tile.getPosition().y;
+        //Players and baits are drawn by 2 entity batches, behind and in front of the depth objects
+        gGameHandler->getDepthSorter().setBatches(this->newObject(FGE_NEWOBJECT(EntityBatch)),
+                                                  this->newObject(FGE_NEWOBJECT(EntityBatch)));
+
+        for (auto const& collider: gMapCache.getColliders())
+        {
+            fge::RectFloat const collisionRect{{collider._x, collider._y}, {collider._width, collider._height}};
 
-                    gGameHandler->pushStaticCollider(collisionRect);
+            gGameHandler->pushStaticCollider(collisionRect);
 #if SHOW_COLLIDERS
-                    objRectCollider.emplace_back(new fge::ObjRectangleShape(collisionRect.getSize()));
-                    objRectCollider.back()->setPosition(collisionRect.getPosition());
-                    objRectCollider.back()->setFillColor(fge::SetAlpha(fge::Color::Red, 100));
-                    objRectCollider.back()->setOutlineColor(fge::Color::Black);
-                    objRectCollider.back()->setOutlineThickness(1.0f);
+            objRectCollider.emplace_back(new fge::ObjRectangleShape(collisionRect.getSize()));
+            objRectCollider.back()->setPosition(collisionRect.getPosition());
+            objRectCollider.back()->setFillColor(fge::SetAlpha(fge::Color::Red, 100));
+            objRectCollider.back()->setOutlineColor(fge::Color::Black);
+            objRectCollider.back()->setOutlineThickness(1.0f);
 #endif
-                }
-            }
         }
         auto const mapBounds = tilemap->findLayerName("Water")->get()->as<fge::TileLayer>()->getGlobalBounds();
 
@@ -277,6 +307,11 @@ public:
                 {{mapBounds.getPosition().x + mapBounds._width, mapBounds.getPosition().y}, {16.0f, 500.0f}}); //Right
         gGameHandler->pushStaticCollider(
                 {{mapBounds.getPosition().x, mapBounds.getPosition().y + mapBounds._height}, {500.0f, 16.0f}}); //Bottom
+#if SHOW_COLLIDERS
+        std::cout << "GameHandler: " << gGameHandler->buildStaticColliders() << " static colliders after merging\n";
+#else
+        gGameHandler->buildStaticColliders();
+#endif
 
 #if SHOW_COLLIDERS
         for (auto const& obj: objRectCollider)
@@ -289,12 +324,13 @@ public:
         auto const specialObjects = tilemap->findLayerName("SpecialObjects")->get()->as<fge::ObjectGroupLayer>();
         objPlayer->boxMove(specialObjects->findObjectName("spawn")->_position);
 
-        //Load duckies
+        //Load duckies, they are all in one flock object
+        auto* duckFlock = this->newObject<DuckFlock>();
         for (auto const& object: specialObjects->getObjects())
         {
             if (object._name == "duckySpawn")
             {
-                this->newObject<Ducky>(object._position);
+                duckFlock->addDuck(object._position);
             }
         }
 
@@ -310,16 +346,24 @@ public:
             {
                 gGameHandler->openPlayerCollection();
             }
+            else if (arg.keysym.sym == F_FRAME_OVERLAY_KEY)
+            {
+                if (auto obj = gGameHandler->getScene().getFirstObj_ByTag("frameTimeOverlay"))
+                {
+                    auto* overlay = obj->getObject<FrameTimeOverlay>();
+                    overlay->setVisible(!overlay->isVisible());
+                }
+            }
         });
 
-        //Setup network events
+        //Setup network events, they are called from the network thread
         network._onClientDisconnected.addLambda([&](fge::net::ClientSideNetUdp& net) {
             std::cout << "Connection lost ! (disconnected from server)" << std::endl;
-            this->stopNetwork(network);
+            networkThread.notifyConnectionLost();
         });
         network._onClientTimeout.addLambda([&](fge::net::ClientSideNetUdp& net) {
             std::cout << "Connection lost ! (timeout)" << std::endl;
-            this->stopNetwork(network);
+            networkThread.notifyConnectionLost();
         });
         network._onTransmitReturnPacket.addLambda(
                 [&](fge::net::ClientSideNetUdp& net, fge::net::TransmitPacketPtr& packet) {
@@ -341,7 +385,11 @@ public:
             switch (event.first)
             {
             case StatEvents::CAUGHT_FISH:
-                this->newObject<MultiplayerFishAward>({FGE_SCENE_PLAN_TOP}, event.second._data, player->getPosition());
+                if (gAssetLoader.isDone(AssetLoader::Groups::DEFERRED))
+                {
+                    this->newObject<MultiplayerFishAward>({FGE_SCENE_PLAN_TOP}, event.second._data,
+                                                          player->getPosition());
+                }
                 break;
             case StatEvents::PLAYER_DISCONNECTED:
                 this->removeNetworkPlayer(event.second._playerId);
@@ -356,80 +404,31 @@ public:
         });
 
         //Connect to the server
-        if (!onlineMode ||
-            !network.start(0, fge::net::IpAddress::Ipv4Any, serverPort, serverIp, fge::net::IpAddress::Types::Ipv4))
-        {
-            std::cout << "Can't start network\n";
-        }
-        else
-        {
-            //Start connection process
-            auto connectResult = network.connect(versioningString);
+        this->g_serverIp = serverIp;
+        this->g_serverPort = serverPort;
+        this->g_versioningString = versioningString;
 
-            connectResult.wait();
-            if (!connectResult.get())
+        if (onlineMode)
+        {
+            auto netPacket = this->requestConnection(network, objPlayer->getPosition(), this->g_sessionToken);
+            if (this->applyConnectionResponse(network, netPacket, *objPlayer))
             {
-                std::cout << "Can't connect to the server\n";
-                this->stopNetwork(network);
-            }
-            else
-            {
-                //Asking for connection
-                auto packet = fge::net::CreatePacket(CLIENT_ASK_CONNECT);
-                packet->doNotDiscard().doNotReorder().packet() << F_NET_CLIENT_HELLO << objPlayer->getPosition();
-                network._client.pushPacket(std::move(packet));
-                network.notifyTransmission();
-                if (network.waitForPackets(F_NET_CLIENT_TIMEOUT_RECEIVE) > 0)
-                {
-                    if (auto netPacket = network.popNextPacket())
-                    {
-                        if (netPacket->retrieveHeaderId().value() == CLIENT_ASK_CONNECT)
-                        {
-                            network._client.getStatus().resetTimeout();
-
-                            bool valid;
-                            netPacket->packet() >> valid;
-                            if (valid)
-                            {
-                                using namespace fge::net::rules;
-                                std::string dataHello;
-                                auto err = RValid(RSizeMustEqual<std::string>(sizeof(F_NET_SERVER_HELLO) - 1,
-                                                                              {netPacket->packet(), &dataHello}))
-                                                   .end();
-
-                                if (err || dataHello != F_NET_SERVER_HELLO)
-                                {
-                                    std::cout << "Error, bad server hello: \n";
-                                    err->dump(std::cout);
-                                    this->stopNetwork(network);
-                                }
-                                else
-                                {
-                                    std::cout << "Connected to the server\n";
-                                    this->applyFullUpdate(netPacket->packet());
-                                    network.enableReturnPacket(true);
-                                    network._client.setPacketReturnRate(
-                                            std::chrono::milliseconds(RETURN_PACKET_DELAYms));
-                                    network.getClientContext()._reorderer.setMaximumSize(
-                                            FGE_NET_PACKET_REORDERER_CACHE_COMPUTE(RETURN_PACKET_DELAYms, F_TICK_TIME));
-                                }
-                            }
-                            else
-                            {
-                                std::string dataString;
-                                netPacket->packet() >> dataString;
-                                std::cout << "Server refused connection: " << dataString << std::endl;
-                                this->stopNetwork(network);
-                            }
-                        }
-                    }
-                }
+                networkThread.start(network);
             }
         }
 
+        //A lost connection is retried in the background, the session is resumed with the session token
+        auto reconnectTime = std::chrono::steady_clock::now() + std::chrono::milliseconds{RECONNECT_DELAYms};
+        std::future<fge::net::ReceivedPacketPtr> reconnectResult;
+
+        FrameLimiter frameLimiter;
+        frameLimiter.setFpsCap(graphicsConfig._fpsCap);
+
         bool running = true;
         while (running)
         {
+            gFrameStats.beginFrame();
+
             //Update events
             event.process(10);
             if (event.isEventType(SDL_QUIT))
@@ -437,61 +436,54 @@ public:
                 running = false;
             }
 
-            //Update
-            auto const deltaTime = std::chrono::duration_cast<fge::DeltaTime>(mainClock.restart());
-            this->update(renderWindow, event, deltaTime);
-            gGameHandler->update(deltaTime);
-
-            //Drawing
-            auto imageIndex = renderWindow.prepareNextFrame(nullptr, FGE_RENDER_TIMEOUT_BLOCKING);
-            if (imageIndex != FGE_RENDER_BAD_IMAGE_INDEX)
+            //Apply the packets received by the network thread
+            if (networkThread.checkConnectionLost())
             {
-                fge::vulkan::GetActiveContext()._garbageCollector.setCurrentFrame(renderWindow.getCurrentFrame());
-
-                renderWindow.beginRenderPass(imageIndex);
-
-                this->draw(renderWindow);
-
-                renderWindow.endRenderPass();
-
-                renderWindow.display(imageIndex);
+                networkThread.stop();
+                this->stopNetwork(network);
+                reconnectTime = std::chrono::steady_clock::now() + std::chrono::milliseconds{RECONNECT_DELAYms};
             }
-
-            //Receive packets
-            fge::net::ReceivedPacketPtr netPacket;
-            fge::net::FluxProcessResults processResult;
-            do {
-                processResult = network.process(netPacket);
-                if (processResult != fge::net::FluxProcessResults::USER_RETRIEVABLE)
-                {
-                    continue;
-                }
-
-                switch (static_cast<PacketHeaders>(netPacket->retrieveHeaderId().value()))
+            if (reconnectResult.valid())
+            {
+                if (reconnectResult.wait_for(std::chrono::seconds{0}) == std::future_status::ready)
                 {
-                case SERVER_UPDATE:
-                    //Unpack latency planner
-                    network._client._latencyPlanner.unpack(netPacket.get(), network._client);
-
-                    if (auto latency = network._client._latencyPlanner.getLatency())
+                    auto netPacket = reconnectResult.get();
+                    if (this->applyConnectionResponse(network, netPacket, *objPlayer))
                     {
-                        network._client.setCTOSLatency_ms(latency.value());
+                        networkThread.start(network);
                     }
-                    if (auto latency = network._client._latencyPlanner.getOtherSideLatency())
+                    else
                     {
-                        network._client.setSTOCLatency_ms(latency.value());
+                        reconnectTime = std::chrono::steady_clock::now() + std::chrono::milliseconds{RECONNECT_DELAYms};
                     }
+                }
+            }
+            else if (onlineMode && !network.isRunning() && std::chrono::steady_clock::now() >= reconnectTime)
+            {
+                std::cout << "Trying to reconnect to the server\n";
+                reconnectResult = std::async(std::launch::async, [this, &network, position = objPlayer->getPosition(),
+                                                                  sessionToken = this->g_sessionToken]() {
+                    return this->requestConnection(network, position, sessionToken);
+                });
+            }
+            InboxPacket inboxPacket;
+            while (networkThread.popPacket(inboxPacket))
+            {
+                auto& netPacket = inboxPacket._packet;
+                switch (static_cast<PacketHeaders>(netPacket->retrieveHeaderId().value()))
+                {
+                case SERVER_UPDATE:
+                {
+                    //The remote objects timestamp their new snapshots with this update time
+                    gGameHandler->getSnapshotClock().pushUpdateTime(inboxPacket._serverTime);
 
-                    //Unpack data
-                    {
-                        fge::Scene::UpdateCountRange updateCountRange{};
-                        this->unpackModification(netPacket->packet(), updateCountRange, true);
-                    }
-                    network._client.getStatus().resetTimeout();
+                    fge::Scene::UpdateCountRange updateCountRange{};
+                    this->unpackModification(netPacket->packet(), updateCountRange, true);
+                }
                     break;
                 case SERVER_FULL_UPDATE:
+                    gGameHandler->getSnapshotClock().pushUpdateTime(inboxPacket._serverTime);
                     this->applyFullUpdate(netPacket->packet());
-                    network._client.getStatus().resetTimeout();
                     break;
                 default:
                     break;
@@ -502,18 +494,52 @@ public:
                     std::cout << "Too many bad packets" << std::endl;
                     gAskForFullUpdate = true;
                 }
-            } while (processResult != fge::net::FluxProcessResults::NONE_AVAILABLE);
+            }
 
-            if (!network.isRunning())
+            //Update
+            auto const deltaTime = std::chrono::duration_cast<fge::DeltaTime>(mainClock.restart());
+            this->update(renderWindow, event, deltaTime);
+            gGameHandler->update(deltaTime);
+            gAssetLoader.processUploads();
+            gPathfindingService.processResults();
+            gFrameStats.mark(FrameStats::METRIC_UPDATE);
+
+            //Drawing, waiting for the next image is counted as present time
+            auto imageIndex = renderWindow.prepareNextFrame(nullptr, FGE_RENDER_TIMEOUT_BLOCKING);
+            gFrameStats.mark(FrameStats::METRIC_PRESENT);
+            if (imageIndex != FGE_RENDER_BAD_IMAGE_INDEX)
             {
-                continue;
+                fge::vulkan::GetActiveContext()._garbageCollector.setCurrentFrame(renderWindow.getCurrentFrame());
+
+                renderWindow.beginRenderPass(imageIndex);
+
+                this->draw(renderWindow);
+
+                renderWindow.endRenderPass();
+                gFrameStats.mark(FrameStats::METRIC_DRAW);
+
+                renderWindow.display(imageIndex);
+                gFrameStats.mark(FrameStats::METRIC_PRESENT);
             }
+
+            frameLimiter.wait();
+            gFrameStats.endFrame();
         }
 
+        if (reconnectResult.valid())
+        {
+            reconnectResult.wait();
+        }
+        networkThread.stop();
         network.disconnect().wait();
         network.stop();
 
+        gAssetLoader.stop();
         this->clear();
+        gGameHandler->getDepthSorter().clear();
+        gPathfindingService.stop();
+        gNavigation.clear();
+        gMapCache.unload();
 
         fge::texture::gManager.uninitialize();
         fge::font::gManager.uninitialize();
@@ -523,6 +549,65 @@ public:
         gGameHandler.reset();
     }
 
+    bool runLoadingScreen(fge::RenderWindow& renderWindow, fge::Event& event)
+    {
+        fge::Scene loadingScene;
+        loadingScene.setLinkedRenderTarget(&renderWindow);
+
+        auto const screenCenter = static_cast<fge::Vector2f>(renderWindow.getSize()) / 2.0f;
+        fge::Vector2f const barSize{400.0f, 24.0f};
+
+        auto* barBackground = loadingScene.newObject<fge::ObjRectangleShape>();
+        barBackground->setSize(barSize);
+        barBackground->setPosition(screenCenter - barSize / 2.0f);
+        barBackground->setFillColor(fge::Color{50, 50, 50, 140});
+        barBackground->setOutlineColor(fge::Color::Black);
+        barBackground->setOutlineThickness(2.0f);
+
+        auto* barFill = loadingScene.newObject<fge::ObjRectangleShape>();
+        barFill->setSize({0.0f, barSize.y});
+        barFill->setPosition(barBackground->getPosition());
+        barFill->setFillColor(fge::Color::White);
+
+        auto* text = loadingScene.newObject<fge::ObjText>();
+        text->setFont("default");
+        text->setCharacterSize(40);
+        text->setFillColor(fge::Color::White);
+        text->setOutlineColor(fge::Color::Black);
+        text->setOutlineThickness(1.8f);
+        text->setString("Loading ...");
+        text->centerOriginFromLocalBounds();
+        text->setPosition(screenCenter - fge::Vector2f{0.0f, barSize.y * 2.0f});
+
+        while (!gAssetLoader.isDone(AssetLoader::Groups::STARTUP))
+        {
+            event.process(10);
+            if (event.isEventType(SDL_QUIT))
+            {
+                return false;
+            }
+
+            gAssetLoader.processUploads();
+            barFill->setSize({barSize.x * gAssetLoader.getProgress(AssetLoader::Groups::STARTUP), barSize.y});
+
+            auto imageIndex = renderWindow.prepareNextFrame(nullptr, FGE_RENDER_TIMEOUT_BLOCKING);
+            if (imageIndex != FGE_RENDER_BAD_IMAGE_INDEX)
+            {
+                fge::vulkan::GetActiveContext()._garbageCollector.setCurrentFrame(renderWindow.getCurrentFrame());
+
+                renderWindow.beginRenderPass(imageIndex);
+
+                loadingScene.draw(renderWindow);
+
+                renderWindow.endRenderPass();
+
+                renderWindow.display(imageIndex);
+            }
+        }
+
+        return true;
+    }
+
     void removeNetworkPlayer(std::string const& playerId)
     {
         auto player = this->findPlayerObject(playerId);
@@ -546,6 +631,136 @@ public:
         network.stop();
         this->removeNetworkElement();
     }
+    /*
+     * Start the network and ask the server for a connection, return the server response or nullptr.
+     *
+     * This doesn't touch the scene, so it can be called from another thread while reconnecting.
+     */
+    fge::net::ReceivedPacketPtr requestConnection(fge::net::ClientSideNetUdp& network,
+                                                  fge::Vector2f const& position,
+                                                  std::string const& sessionToken) const
+    {
+        auto netPacket = this->requestConnection(network, position, sessionToken, this->g_serverPort);
+        if (netPacket == nullptr)
+        {
+            return nullptr;
+        }
+
+        //A sharded server redirects us to one of its shards
+        auto response = netPacket->packet();
+        bool valid = true;
+        std::string reason;
+        fge::net::Port shardPort = 0;
+        response >> valid;
+        if (valid || !(response >> reason >> shardPort).isValid() || reason != F_NET_SERVER_REDIRECT)
+        {
+            return netPacket;
+        }
+
+        network.stop();
+        return this->requestConnection(network, position, sessionToken, shardPort);
+    }
+    fge::net::ReceivedPacketPtr requestConnection(fge::net::ClientSideNetUdp& network,
+                                                  fge::Vector2f const& position,
+                                                  std::string const& sessionToken,
+                                                  fge::net::Port port) const
+    {
+        if (!network.start(0, fge::net::IpAddress::Ipv4Any, port, this->g_serverIp, fge::net::IpAddress::Types::Ipv4))
+        {
+            std::cout << "Can't start network\n";
+            return nullptr;
+        }
+
+        //Start connection process
+        auto connectResult = network.connect(this->g_versioningString);
+
+        connectResult.wait();
+        if (!connectResult.get())
+        {
+            std::cout << "Can't connect to the server\n";
+            network.stop();
+            return nullptr;
+        }
+
+        //Asking for connection, the session token is empty for a new session
+        auto packet = fge::net::CreatePacket(CLIENT_ASK_CONNECT);
+        packet->doNotDiscard().doNotReorder().packet() << F_NET_CLIENT_HELLO << position << sessionToken;
+        network._client.pushPacket(std::move(packet));
+        network.notifyTransmission();
+        if (network.waitForPackets(F_NET_CLIENT_TIMEOUT_RECEIVE) > 0)
+        {
+            if (auto netPacket = network.popNextPacket())
+            {
+                if (netPacket->retrieveHeaderId().value() == CLIENT_ASK_CONNECT)
+                {
+                    return netPacket;
+                }
+            }
+        }
+
+        std::cout << "No response from the server\n";
+        network.stop();
+        return nullptr;
+    }
+    //Return true if the connection is accepted, the network is stopped otherwise
+    bool applyConnectionResponse(fge::net::ClientSideNetUdp& network,
+                                 fge::net::ReceivedPacketPtr const& netPacket,
+                                 Player& player)
+    {
+        if (netPacket == nullptr)
+        {
+            this->stopNetwork(network);
+            return false;
+        }
+
+        network._client.getStatus().resetTimeout();
+
+        bool valid;
+        netPacket->packet() >> valid;
+        if (!valid)
+        {
+            std::string dataString;
+            netPacket->packet() >> dataString;
+            std::cout << "Server refused connection: " << dataString << std::endl;
+            this->stopNetwork(network);
+            return false;
+        }
+
+        using namespace fge::net::rules;
+        std::string dataHello;
+        auto err = RValid(RSizeMustEqual<std::string>(sizeof(F_NET_SERVER_HELLO) - 1,
+                                                      {netPacket->packet(), &dataHello}))
+                           .end();
+
+        if (err || dataHello != F_NET_SERVER_HELLO)
+        {
+            std::cout << "Error, bad server hello: \n";
+            if (err)
+            {
+                err->dump(std::cout);
+            }
+            this->stopNetwork(network);
+            return false;
+        }
+
+        //The server gives back the position of a resumed session, or our own
+        fge::Vector2f position;
+        fge::Vector2i direction;
+        netPacket->packet() >> position >> direction >> this->g_sessionToken;
+        player.boxMove(position - player.getPosition());
+        player.setDirection(direction);
+
+        std::cout << "Connected to the server\n";
+        //The remote players timestamp the full update with a fresh clock
+        gGameHandler->getSnapshotClock().reset();
+        gGameHandler->getSnapshotClock().pushUpdateTime(std::chrono::steady_clock::now());
+        this->applyFullUpdate(netPacket->packet());
+        network.enableReturnPacket(true);
+        network._client.setPacketReturnRate(std::chrono::milliseconds(RETURN_PACKET_DELAYms));
+        network.getClientContext()._reorderer.setMaximumSize(
+                FGE_NET_PACKET_REORDERER_CACHE_COMPUTE(RETURN_PACKET_DELAYms, F_TICK_TIME));
+        return true;
+    }
     void applyFullUpdate(fge::net::Packet& packet)
     {
         this->removeNetworkElement(); //TODO: remove only the ones that are not in the server
@@ -579,6 +794,11 @@ public:
 
 private:
     fge::net::NetworkTypeEvents<StatEvents, PlayerEventData>* g_playerEvents{nullptr};
+
+    fge::net::IpAddress g_serverIp;
+    fge::net::Port g_serverPort{0};
+    std::string g_versioningString;
+    std::string g_sessionToken;
 };
 
 int main(int argc, char* argv[])
@@ -663,8 +883,9 @@ int main(int argc, char* argv[])
 
     fge::RenderWindow renderWindow(vulkanContext, window);
     renderWindow.setClearColor(fge::Color(239, 205, 173));
-    renderWindow.setPresentMode(VK_PRESENT_MODE_FIFO_KHR);
-    //renderWindow.setVerticalSyncEnabled( sc::ConfigVsync() );
+
+    auto const graphicsConfig = LoadGraphicsConfig(F_GRAPHICS_CONFIG_FILE);
+    renderWindow.setPresentMode(graphicsConfig._presentMode);
 
     fge::net::ClientSideNetUdp network;
 
@@ -676,7 +897,7 @@ int main(int argc, char* argv[])
     do {
         GetActiveContext()._garbageCollector.enable(true);
 
-        currentScene->run(renderWindow, network);
+        currentScene->run(renderWindow, network, graphicsConfig);
 
         GetActiveContext().waitIdle();
         GetActiveContext()._garbageCollector.enable(false);
@@ -0,0 +1,651 @@
+#include "mapCache.hpp"
+#include "colliderBuilder.hpp"
+#include "FastEngine/extra/extra_function.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+struct MapCache::Header
+{
+    char _magic[4];
+    uint32_t _version;
+
+    //Source map used to check if the cache is outdated
+    uint64_t _sourceSize;
+    int64_t _sourceTime;
+
+    uint32_t _gridWidth;
+    uint32_t _gridHeight;
+    float _tileWidth;
+    float _tileHeight;
+    float _originX;
+    float _originY;
+
+    uint32_t _tilesetCount;
+    uint32_t _layerCount;
+    uint32_t _colliderCount;
+    uint32_t _depthLineCount;
+    uint32_t _waterSubdivision;
+
+    uint64_t _tilesetsOffset;
+    uint64_t _layersOffset;
+    uint64_t _collidersOffset;
+    uint64_t _waterOffset;
+    uint64_t _walkableOffset;
+    uint64_t _depthLinesOffset;
+};
+
+//External tileset of the source map, also used to check if the cache is outdated
+struct MapCache::Tileset
+{
+    char _path[F_MAP_CACHE_TILESET_PATH_SIZE];
+    uint64_t _size;
+    int64_t _time;
+};
+
+struct MapCache::Layer
+{
+    char _name[F_MAP_CACHE_LAYER_NAME_SIZE];
+    uint32_t _width;
+    uint32_t _height;
+    uint64_t _gidsOffset;
+};
+
+namespace
+{
+
+template<class T>
+uint64_t AppendSection(std::vector<uint8_t>& data, T const* elements, std::size_t count)
+{
+    //Every section is 8 bytes aligned
+    data.resize((data.size() + 7) & ~std::size_t{7});
+    auto const offset = data.size();
+    data.resize(offset + sizeof(T) * count);
+    if (count != 0)
+    {
+        std::memcpy(data.data() + offset, elements, sizeof(T) * count);
+    }
+    return offset;
+}
+
+std::size_t BitsetWordCount(std::size_t bitCount)
+{
+    return (bitCount + 63) / 64;
+}
+void SetBit(std::vector<uint64_t>& bitset, std::size_t index)
+{
+    bitset[index / 64] |= uint64_t{1} << (index % 64);
+}
+bool GetBit(uint64_t const* bitset, std::size_t index)
+{
+    return (bitset[index / 64] >> (index % 64) & 1) != 0;
+}
+
+bool GetSourceInfo(std::filesystem::path const& sourcePath, uint64_t& size, int64_t& time)
+{
+    std::error_code err;
+    size = std::filesystem::file_size(sourcePath, err);
+    if (err)
+    {
+        return false;
+    }
+    auto const writeTime = std::filesystem::last_write_time(sourcePath, err);
+    if (err)
+    {
+        return false;
+    }
+    time = static_cast<int64_t>(writeTime.time_since_epoch().count());
+    return true;
+}
+//Only used when baking, a valid cache never parses the json
+bool GetSourceTilesets(std::filesystem::path const& sourcePath, std::vector<std::filesystem::path>& tilesets)
+{
+    nlohmann::json jsonMap;
+    if (!fge::LoadJsonFromFile(sourcePath, jsonMap))
+    {
+        return false;
+    }
+
+    auto const tilesetsIt = jsonMap.find("tilesets");
+    if (tilesetsIt == jsonMap.end() || !tilesetsIt->is_array())
+    {
+        return true;
+    }
+    for (auto const& tileset: *tilesetsIt)
+    {
+        auto const sourceIt = tileset.find("source");
+        if (sourceIt == tileset.end() || !sourceIt->is_string())
+        { //Embedded tileset, already part of the map file
+            continue;
+        }
+        tilesets.push_back((sourcePath.parent_path() / sourceIt->get<std::string>()).lexically_normal());
+    }
+    return true;
+}
+
+} // namespace
+
+MapCache::~MapCache()
+{
+    this->unload();
+}
+
+bool MapCache::loadOrBake(fge::TileMap const& tileMap,
+                          std::filesystem::path const& sourcePath,
+                          std::filesystem::path const& cachePath)
+{
+    if (this->load(cachePath, sourcePath))
+    {
+        return true;
+    }
+
+    std::cout << "MapCache: baking " << sourcePath << "\n";
+    auto data = bake(tileMap, sourcePath);
+    if (data.empty())
+    {
+        return false;
+    }
+
+    if (save(data, cachePath) && this->load(cachePath, sourcePath))
+    {
+        return true;
+    }
+    //The cache can't be written, keep it in memory for this run
+    return this->loadFromMemory(std::move(data), sourcePath);
+}
+
+bool MapCache::load(std::filesystem::path const& cachePath, std::filesystem::path const& sourcePath)
+{
+    this->unload();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileW(cachePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(file, &fileSize) == 0 || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr)
+    {
+        return false;
+    }
+
+    auto const* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr)
+    {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    this->g_mapping = mapping;
+    this->g_data = static_cast<uint8_t const*>(data);
+    this->g_size = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+    int const file = open(cachePath.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        return false;
+    }
+
+    struct stat fileStat{};
+    if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        close(file);
+        return false;
+    }
+
+    void* data = mmap(nullptr, static_cast<std::size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    this->g_mapping = data;
+    this->g_data = static_cast<uint8_t const*>(data);
+    this->g_size = static_cast<std::size_t>(fileStat.st_size);
+#endif
+
+    if (!this->fixUp(sourcePath))
+    {
+        this->unload();
+        return false;
+    }
+    return true;
+}
+bool MapCache::loadFromMemory(std::vector<uint8_t>&& data, std::filesystem::path const& sourcePath)
+{
+    this->unload();
+
+    this->g_buffer = std::move(data);
+    this->g_data = this->g_buffer.data();
+    this->g_size = this->g_buffer.size();
+
+    if (!this->fixUp(sourcePath))
+    {
+        this->unload();
+        return false;
+    }
+    return true;
+}
+void MapCache::unload()
+{
+    if (this->g_mapping != nullptr)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(this->g_data);
+        CloseHandle(static_cast<HANDLE>(this->g_mapping));
+#else
+        munmap(this->g_mapping, this->g_size);
+#endif
+        this->g_mapping = nullptr;
+    }
+    this->g_buffer.clear();
+    this->g_buffer.shrink_to_fit();
+
+    this->g_data = nullptr;
+    this->g_size = 0;
+    this->g_header = nullptr;
+    this->g_layers = nullptr;
+    this->g_colliders = nullptr;
+    this->g_water = nullptr;
+    this->g_walkable = nullptr;
+    this->g_depthLines = nullptr;
+}
+bool MapCache::isLoaded() const
+{
+    return this->g_header != nullptr;
+}
+
+bool MapCache::fixUp(std::filesystem::path const& sourcePath)
+{
+    if (this->g_size < sizeof(Header))
+    {
+        return false;
+    }
+
+    auto const* header = reinterpret_cast<Header const*>(this->g_data);
+    if (std::memcmp(header->_magic, F_MAP_CACHE_MAGIC, 4) != 0 || header->_version != F_MAP_CACHE_VERSION)
+    {
+        return false;
+    }
+
+    uint64_t sourceSize = 0;
+    int64_t sourceTime = 0;
+    if (!GetSourceInfo(sourcePath, sourceSize, sourceTime) || header->_sourceSize != sourceSize ||
+        header->_sourceTime != sourceTime)
+    {
+        std::cout << "MapCache: the cache is outdated\n";
+        return false;
+    }
+
+    auto const checkSection = [&](uint64_t offset, std::size_t size) {
+        return offset % 8 == 0 && offset <= this->g_size && size <= this->g_size - offset;
+    };
+
+    std::size_t const tileCount = std::size_t{header->_gridWidth} * header->_gridHeight;
+    std::size_t const waterCellCount = tileCount * header->_waterSubdivision * header->_waterSubdivision;
+
+    if (!checkSection(header->_tilesetsOffset, sizeof(Tileset) * header->_tilesetCount) ||
+        !checkSection(header->_layersOffset, sizeof(Layer) * header->_layerCount) ||
+        !checkSection(header->_collidersOffset, sizeof(Rect) * header->_colliderCount) ||
+        !checkSection(header->_waterOffset, sizeof(uint64_t) * BitsetWordCount(waterCellCount)) ||
+        !checkSection(header->_walkableOffset, sizeof(uint64_t) * BitsetWordCount(tileCount)) ||
+        !checkSection(header->_depthLinesOffset, sizeof(float) * header->_depthLineCount))
+    {
+        return false;
+    }
+
+    //The tilesets are only checked with their file info, as the source map
+    auto const* tilesets = reinterpret_cast<Tileset const*>(this->g_data + header->_tilesetsOffset);
+    for (uint32_t i = 0; i < header->_tilesetCount; ++i)
+    {
+        auto const& tileset = tilesets[i];
+        std::filesystem::path const tilesetPath{
+                std::string{tileset._path, strnlen(tileset._path, F_MAP_CACHE_TILESET_PATH_SIZE)}};
+        if (!GetSourceInfo(tilesetPath, sourceSize, sourceTime) || tileset._size != sourceSize ||
+            tileset._time != sourceTime)
+        {
+            std::cout << "MapCache: the cache is outdated\n";
+            return false;
+        }
+    }
+
+    auto const* layers = reinterpret_cast<Layer const*>(this->g_data + header->_layersOffset);
+    for (uint32_t i = 0; i < header->_layerCount; ++i)
+    {
+        if (!checkSection(layers[i]._gidsOffset, sizeof(uint32_t) * layers[i]._width * layers[i]._height))
+        {
+            return false;
+        }
+    }
+
+    this->g_header = header;
+    this->g_layers = layers;
+    this->g_colliders = reinterpret_cast<Rect const*>(this->g_data + header->_collidersOffset);
+    this->g_water = reinterpret_cast<uint64_t const*>(this->g_data + header->_waterOffset);
+    this->g_walkable = reinterpret_cast<uint64_t const*>(this->g_data + header->_walkableOffset);
+    this->g_depthLines = reinterpret_cast<float const*>(this->g_data + header->_depthLinesOffset);
+    return true;
+}
+
+std::vector<uint8_t> MapCache::bake(fge::TileMap const& tileMap, std::filesystem::path const& sourcePath)
+{
+    Header header{};
+    std::memcpy(header._magic, F_MAP_CACHE_MAGIC, 4);
+    header._version = F_MAP_CACHE_VERSION;
+    header._waterSubdivision = F_MAP_CACHE_WATER_SUBDIVISION;
+    if (!GetSourceInfo(sourcePath, header._sourceSize, header._sourceTime))
+    {
+        return {};
+    }
+
+    std::vector<std::filesystem::path> tilesetPaths;
+    if (!GetSourceTilesets(sourcePath, tilesetPaths))
+    {
+        return {};
+    }
+    std::vector<Tileset> tilesets(tilesetPaths.size());
+    for (std::size_t i = 0; i < tilesetPaths.size(); ++i)
+    {
+        auto const path = tilesetPaths[i].generic_string();
+        if (path.size() >= F_MAP_CACHE_TILESET_PATH_SIZE ||
+            !GetSourceInfo(tilesetPaths[i], tilesets[i]._size, tilesets[i]._time))
+        {
+            std::cout << "MapCache: can't use the tileset " << tilesetPaths[i] << "\n";
+            return {};
+        }
+        std::strncpy(tilesets[i]._path, path.c_str(), F_MAP_CACHE_TILESET_PATH_SIZE - 1);
+    }
+
+    auto const waterIt = tileMap.findLayerName(F_MAP_LAYER_WATER);
+    auto const depthObjectsIt = tileMap.findLayerName(F_MAP_LAYER_DEPTH_OBJECTS);
+    if (waterIt == tileMap._layers.end() || depthObjectsIt == tileMap._layers.end())
+    {
+        std::cout << "MapCache: the map must have a \"" F_MAP_LAYER_WATER "\" and a \"" F_MAP_LAYER_DEPTH_OBJECTS
+                     "\" tile layer\n";
+        return {};
+    }
+    auto const* waterLayer = waterIt->get()->as<fge::TileLayer>();
+    auto const* depthObjectsLayer = depthObjectsIt->get()->as<fge::TileLayer>();
+
+    auto const gridSize = waterLayer->getTiles().getSize();
+    header._gridWidth = static_cast<uint32_t>(gridSize.x);
+    header._gridHeight = static_cast<uint32_t>(gridSize.y);
+    header._originX = waterLayer->getPosition().x;
+    header._originY = waterLayer->getPosition().y;
+
+    std::vector<Layer> layers;
+    std::vector<std::vector<uint32_t>> layerGids;
+    std::vector<fge::RectFloat> collisionRects;
+    fge::Vector2i tileSize{0, 0};
+
+    for (auto const& baseLayer: tileMap._layers)
+    {
+        if (baseLayer->getType() != fge::BaseLayer::Types::TILE_LAYER)
+        {
+            continue;
+        }
+        auto const* layer = baseLayer->as<fge::TileLayer>();
+        auto const& tiles = layer->getTiles();
+
+        auto& layerEntry = layers.emplace_back();
+        std::strncpy(layerEntry._name, layer->getName().c_str(), F_MAP_CACHE_LAYER_NAME_SIZE - 1);
+        layerEntry._width = static_cast<uint32_t>(tiles.getSize().x);
+        layerEntry._height = static_cast<uint32_t>(tiles.getSize().y);
+
+        auto& gids = layerGids.emplace_back();
+        gids.resize(tiles.getSize().x * tiles.getSize().y, 0);
+
+        for (std::size_t y = 0; y < tiles.getSize().y; ++y)
+        {
+            for (std::size_t x = 0; x < tiles.getSize().x; ++x)
+            {
+                auto const& tile = tiles.get(x, y);
+                if (tile.getGid() == 0)
+                {
+                    continue;
+                }
+                gids[y * tiles.getSize().x + x] = static_cast<uint32_t>(tile.getGid());
+
+                if (tileSize.x == 0 && tileSize.y == 0)
+                {
+                    tileSize = tile.getTileSet()->getTileSize();
+                }
+
+                for (auto const& collision: tile.getTileData()->_collisionRects)
+                {
+                    auto collisionRect = static_cast<fge::RectFloat>(collision);
+                    collisionRect._x += tile.getPosition().x;
+                    collisionRect._y += tile.getPosition().y;
+                    collisionRects.push_back(collisionRect);
+                }
+            }
+        }
+    }
+
+    //Colliders are stored already merged
+    ColliderBuilder::MergeRects(collisionRects);
+    std::vector<Rect> colliders;
+    colliders.reserve(collisionRects.size());
+    for (auto const& rect: collisionRects)
+    {
+        colliders.push_back({rect._x, rect._y, rect._width, rect._height});
+    }
+
+    header._tileWidth = static_cast<float>(tileSize.x);
+    header._tileHeight = static_cast<float>(tileSize.y);
+
+    //Water, a cell is water if its center is inside one of the water tile collision rects
+    auto const subdivision = std::size_t{F_MAP_CACHE_WATER_SUBDIVISION};
+    auto const waterWidth = gridSize.x * subdivision;
+    std::vector<uint64_t> water(BitsetWordCount(waterWidth * gridSize.y * subdivision), 0);
+    //Walkability, same rules as the ducky path finding: no water and no colliding depth object
+    std::vector<uint64_t> walkable(BitsetWordCount(gridSize.x * gridSize.y), 0);
+
+    for (std::size_t y = 0; y < gridSize.y; ++y)
+    {
+        for (std::size_t x = 0; x < gridSize.x; ++x)
+        {
+            auto const& waterTile = waterLayer->getTiles().get(x, y);
+            if (waterTile.getGid() != 0)
+            {
+                for (std::size_t cy = 0; cy < subdivision; ++cy)
+                {
+                    for (std::size_t cx = 0; cx < subdivision; ++cx)
+                    {
+                        fge::Vector2f const cellCenter{
+                                (static_cast<float>(cx) + 0.5f) * header._tileWidth / static_cast<float>(subdivision),
+                                (static_cast<float>(cy) + 0.5f) * header._tileHeight / static_cast<float>(subdivision)};
+
+                        for (auto const& rect: waterTile.getTileData()->_collisionRects)
+                        {
+                            if (static_cast<fge::RectFloat>(rect).contains(cellCenter))
+                            {
+                                SetBit(water, (y * subdivision + cy) * waterWidth + x * subdivision + cx);
+                                break;
+                            }
+                        }
+                    }
+                }
+                continue;
+            }
+
+            if (y < depthObjectsLayer->getTiles().getSize().y && x < depthObjectsLayer->getTiles().getSize().x)
+            {
+                auto const& objectTile = depthObjectsLayer->getTiles().get(x, y);
+                if (objectTile.getGid() != 0 && !objectTile.getTileData()->_collisionRects.empty())
+                {
+                    continue;
+                }
+            }
+            SetBit(walkable, y * gridSize.x + x);
+        }
+    }
+
+    //Depth lines, the center of every depth object
+    std::vector<float> depthLines;
+    for (auto const& tile: depthObjectsLayer->getTiles())
+    {
+        if (tile.getGid() != FGE_LAYER_BAD_ID)
+        {
+            depthLines.push_back(depthObjectsLayer->getPosition().y + tile.getPosition().y + header._tileHeight / 2.0f);
+        }
+    }
+    std::ranges::sort(depthLines);
+    depthLines.erase(std::unique(depthLines.begin(), depthLines.end()), depthLines.end());
+
+    header._tilesetCount = static_cast<uint32_t>(tilesets.size());
+    header._layerCount = static_cast<uint32_t>(layers.size());
+    header._colliderCount = static_cast<uint32_t>(colliders.size());
+    header._depthLineCount = static_cast<uint32_t>(depthLines.size());
+
+    std::vector<uint8_t> data(sizeof(Header));
+    for (std::size_t i = 0; i < layers.size(); ++i)
+    {
+        layers[i]._gidsOffset = AppendSection(data, layerGids[i].data(), layerGids[i].size());
+    }
+    header._tilesetsOffset = AppendSection(data, tilesets.data(), tilesets.size());
+    header._layersOffset = AppendSection(data, layers.data(), layers.size());
+    header._collidersOffset = AppendSection(data, colliders.data(), colliders.size());
+    header._waterOffset = AppendSection(data, water.data(), water.size());
+    header._walkableOffset = AppendSection(data, walkable.data(), walkable.size());
+    header._depthLinesOffset = AppendSection(data, depthLines.data(), depthLines.size());
+
+    std::memcpy(data.data(), &header, sizeof(Header));
+    return data;
+}
+bool MapCache::save(std::vector<uint8_t> const& data, std::filesystem::path const& cachePath)
+{
+    //Another client can have the old cache mapped, it must be replaced and never rewritten in place
+    auto tmpPath = cachePath;
+    tmpPath += ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            std::cout << "MapCache: can't write " << tmpPath << "\n";
+            return false;
+        }
+        file.write(reinterpret_cast<char const*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file.flush())
+        {
+            std::cout << "MapCache: can't write " << tmpPath << "\n";
+            file.close();
+            std::error_code err;
+            std::filesystem::remove(tmpPath, err);
+            return false;
+        }
+    }
+
+    std::error_code err;
+    std::filesystem::rename(tmpPath, cachePath, err);
+    if (err)
+    {
+        std::cout << "MapCache: can't replace " << cachePath << ": " << err.message() << "\n";
+        std::filesystem::remove(tmpPath, err);
+        return false;
+    }
+    return true;
+}
+
+fge::Vector2size MapCache::getGridSize() const
+{
+    return {this->g_header->_gridWidth, this->g_header->_gridHeight};
+}
+fge::Vector2f MapCache::getTileSize() const
+{
+    return {this->g_header->_tileWidth, this->g_header->_tileHeight};
+}
+std::optional<fge::Vector2size> MapCache::getGridPosition(fge::Vector2f const& position) const
+{
+    auto const x = (position.x - this->g_header->_originX) / this->g_header->_tileWidth;
+    auto const y = (position.y - this->g_header->_originY) / this->g_header->_tileHeight;
+    if (x < 0.0f || y < 0.0f || x >= static_cast<float>(this->g_header->_gridWidth) ||
+        y >= static_cast<float>(this->g_header->_gridHeight))
+    {
+        return std::nullopt;
+    }
+    return fge::Vector2size{static_cast<std::size_t>(x), static_cast<std::size_t>(y)};
+}
+fge::Vector2f MapCache::getTileCenter(fge::Vector2size const& gridPosition) const
+{
+    return {this->g_header->_originX + (static_cast<float>(gridPosition.x) + 0.5f) * this->g_header->_tileWidth,
+            this->g_header->_originY + (static_cast<float>(gridPosition.y) + 0.5f) * this->g_header->_tileHeight};
+}
+
+std::span<uint32_t const> MapCache::getLayerGids(std::string_view layerName) const
+{
+    for (uint32_t i = 0; i < this->g_header->_layerCount; ++i)
+    {
+        auto const& layer = this->g_layers[i];
+        if (layerName == std::string_view{layer._name, strnlen(layer._name, F_MAP_CACHE_LAYER_NAME_SIZE)})
+        {
+            return {reinterpret_cast<uint32_t const*>(this->g_data + layer._gidsOffset),
+                    std::size_t{layer._width} * layer._height};
+        }
+    }
+    return {};
+}
+std::span<MapCache::Rect const> MapCache::getColliders() const
+{
+    return {this->g_colliders, this->g_header->_colliderCount};
+}
+std::span<float const> MapCache::getDepthLines() const
+{
+    return {this->g_depthLines, this->g_header->_depthLineCount};
+}
+
+bool MapCache::isWater(fge::Vector2f const& position) const
+{
+    auto const subdivision = this->g_header->_waterSubdivision;
+    auto const cellWidth = this->g_header->_tileWidth / static_cast<float>(subdivision);
+    auto const cellHeight = this->g_header->_tileHeight / static_cast<float>(subdivision);
+
+    auto const x = (position.x - this->g_header->_originX) / cellWidth;
+    auto const y = (position.y - this->g_header->_originY) / cellHeight;
+    auto const waterWidth = std::size_t{this->g_header->_gridWidth} * subdivision;
+    auto const waterHeight = std::size_t{this->g_header->_gridHeight} * subdivision;
+    if (x < 0.0f || y < 0.0f || x >= static_cast<float>(waterWidth) || y >= static_cast<float>(waterHeight))
+    {
+        return false;
+    }
+
+    return GetBit(this->g_water, static_cast<std::size_t>(y) * waterWidth + static_cast<std::size_t>(x));
+}
+bool MapCache::isWalkable(fge::Vector2size const& gridPosition) const
+{
+    if (gridPosition.x >= this->g_header->_gridWidth || gridPosition.y >= this->g_header->_gridHeight)
+    {
+        return false;
+    }
+    return GetBit(this->g_walkable, gridPosition.y * this->g_header->_gridWidth + gridPosition.x);
+}
+
+MapCache gMapCache;
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "FastEngine/C_rect.hpp"
+#include "FastEngine/object/C_objTilelayer.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#define F_MAP_CACHE_MAGIC "FMAP"
+#define F_MAP_CACHE_VERSION 4
+#define F_MAP_CACHE_EXTENSION ".fmap"
+
+#define F_MAP_CACHE_LAYER_NAME_SIZE 32
+#define F_MAP_CACHE_TILESET_PATH_SIZE 256
+//Water mask cells per tile side, the bait check needs better than tile precision
+#define F_MAP_CACHE_WATER_SUBDIVISION 4
+
+#define F_MAP_LAYER_WATER "Water"
+#define F_MAP_LAYER_DEPTH_OBJECTS "DepthObjects"
+
+/*
+ * Precompiled binary map.
+ *
+ * Everything the game needs from the map outside of the rendering is baked once from the loaded "tiled" map:
+ * the tile grids, the merged collision rectangles in world space, a water bitset, a walkability bitset and the sorted
+ * depth lines. The cache is written next to the json and is rebuilt when the json or one of its tilesets changes.
+ *
+ * The cache file is memory mapped, loading it is only a validation (the size and time of the source files) and a
+ * pointer fix-up of every section, the json is never parsed for it. The rendering is not part of the cache:
+ * fge::TileMap still builds the tile layer objects from the json, which is then the only parse of a warm start.
+ */
+class MapCache
+{
+public:
+    struct Rect
+    {
+        float _x;
+        float _y;
+        float _width;
+        float _height;
+    };
+
+    MapCache() = default;
+    MapCache(MapCache const& r) = delete;
+    MapCache(MapCache&& r) noexcept = delete;
+    ~MapCache();
+
+    MapCache& operator=(MapCache const& r) = delete;
+    MapCache& operator=(MapCache&& r) noexcept = delete;
+
+    //Map the cache if it is valid and up to date with the source map, else bake it from the given tileMap
+    bool loadOrBake(fge::TileMap const& tileMap,
+                    std::filesystem::path const& sourcePath,
+                    std::filesystem::path const& cachePath);
+
+    bool load(std::filesystem::path const& cachePath, std::filesystem::path const& sourcePath);
+    bool loadFromMemory(std::vector<uint8_t>&& data, std::filesystem::path const& sourcePath);
+    void unload();
+    [[nodiscard]] bool isLoaded() const;
+
+    [[nodiscard]] static std::vector<uint8_t> bake(fge::TileMap const& tileMap,
+                                                   std::filesystem::path const& sourcePath);
+    static bool save(std::vector<uint8_t> const& data, std::filesystem::path const& cachePath);
+
+    [[nodiscard]] fge::Vector2size getGridSize() const;
+    [[nodiscard]] fge::Vector2f getTileSize() const;
+    [[nodiscard]] std::optional<fge::Vector2size> getGridPosition(fge::Vector2f const& position) const;
+    [[nodiscard]] fge::Vector2f getTileCenter(fge::Vector2size const& gridPosition) const;
+
+    [[nodiscard]] std::span<uint32_t const> getLayerGids(std::string_view layerName) const;
+    [[nodiscard]] std::span<Rect const> getColliders() const;
+    //Sorted y of every depth object center
+    [[nodiscard]] std::span<float const> getDepthLines() const;
+
+    [[nodiscard]] bool isWater(fge::Vector2f const& position) const;
+    [[nodiscard]] bool isWalkable(fge::Vector2size const& gridPosition) const;
+
+private:
+    struct Header;
+    struct Tileset;
+    struct Layer;
+
+    bool fixUp(std::filesystem::path const& sourcePath);
+
+    //Mapped file (or owned buffer when the cache can't be written)
+    uint8_t const* g_data{nullptr};
+    std::size_t g_size{0};
+    void* g_mapping{nullptr};
+    std::vector<uint8_t> g_buffer;
+
+    Header const* g_header{nullptr};
+    Layer const* g_layers{nullptr};
+    Rect const* g_colliders{nullptr};
+    uint64_t const* g_water{nullptr};
+    uint64_t const* g_walkable{nullptr};
+    float const* g_depthLines{nullptr};
+};
+
+extern MapCache gMapCache;
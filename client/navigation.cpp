@@ -0,0 +1,158 @@
+#include "navigation.hpp"
+#include "FastEngine/C_random.hpp"
+#include "mapCache.hpp"
+
+bool Navigation::build(MapCache const& mapCache)
+{
+    this->clear();
+
+    if (!mapCache.isLoaded())
+    {
+        return false;
+    }
+
+    this->g_mapCache = &mapCache;
+    this->g_gridSize = mapCache.getGridSize();
+
+    std::vector<uint8_t> walkable(this->g_gridSize.x * this->g_gridSize.y, 0);
+    for (std::size_t y = 0; y < this->g_gridSize.y; ++y)
+    {
+        for (std::size_t x = 0; x < this->g_gridSize.x; ++x)
+        {
+            walkable[this->getIndex({x, y})] = mapCache.isWalkable({x, y}) ? 1 : 0;
+        }
+    }
+    this->g_pathfinder.build(this->g_gridSize, std::move(walkable));
+
+    //Group the walkable cells by connected region (flood fill)
+    this->g_cellRegions.assign(this->g_gridSize.x * this->g_gridSize.y, F_NAV_BAD_REGION);
+
+    std::vector<fge::Vector2size> stack;
+    for (std::size_t y = 0; y < this->g_gridSize.y; ++y)
+    {
+        for (std::size_t x = 0; x < this->g_gridSize.x; ++x)
+        {
+            if (this->g_cellRegions[this->getIndex({x, y})] != F_NAV_BAD_REGION || !mapCache.isWalkable({x, y}))
+            {
+                continue;
+            }
+
+            auto const region = static_cast<uint32_t>(this->g_regionCells.size());
+            auto& regionCells = this->g_regionCells.emplace_back();
+
+            stack.push_back({x, y});
+            this->g_cellRegions[this->getIndex({x, y})] = region;
+            while (!stack.empty())
+            {
+                auto const cell = stack.back();
+                stack.pop_back();
+                regionCells.push_back(cell);
+
+                fge::Vector2size const neighbors[4] = {
+                        {cell.x - 1, cell.y}, {cell.x + 1, cell.y}, {cell.x, cell.y - 1}, {cell.x, cell.y + 1}};
+                for (auto const& neighbor: neighbors)
+                { //Out of bounds cells (including the unsigned wrap) are not walkable
+                    if (mapCache.isWalkable(neighbor) &&
+                        this->g_cellRegions[this->getIndex(neighbor)] == F_NAV_BAD_REGION)
+                    {
+                        this->g_cellRegions[this->getIndex(neighbor)] = region;
+                        stack.push_back(neighbor);
+                    }
+                }
+            }
+        }
+    }
+
+    return true;
+}
+void Navigation::clear()
+{
+    this->g_mapCache = nullptr;
+    this->g_gridSize = {0, 0};
+    this->g_pathfinder.clear();
+    this->g_cellRegions.clear();
+    this->g_regionCells.clear();
+    this->g_pathCache.clear();
+    this->g_pathCacheLru.clear();
+    this->g_cacheHitCount = 0;
+    this->g_cacheMissCount = 0;
+}
+bool Navigation::isBuilt() const
+{
+    return this->g_mapCache != nullptr;
+}
+
+uint32_t Navigation::getRegion(fge::Vector2size const& cell) const
+{
+    if (cell.x >= this->g_gridSize.x || cell.y >= this->g_gridSize.y)
+    {
+        return F_NAV_BAD_REGION;
+    }
+    return this->g_cellRegions[this->getIndex(cell)];
+}
+std::optional<fge::Vector2size> Navigation::getRandomDestination(fge::Vector2size const& from) const
+{
+    auto const region = this->getRegion(from);
+    if (region == F_NAV_BAD_REGION)
+    {
+        return std::nullopt;
+    }
+
+    auto const& cells = this->g_regionCells[region];
+    return cells[fge::_random.range<std::size_t>(0, cells.size() - 1)];
+}
+
+std::vector<fge::Vector2f> Navigation::findPath(fge::Vector2size const& from, fge::Vector2size const& to)
+{
+    if (!this->isBuilt() || this->getRegion(from) == F_NAV_BAD_REGION ||
+        this->getRegion(from) != this->getRegion(to))
+    {
+        return {};
+    }
+
+    PathKey const key = static_cast<PathKey>(this->getIndex(from)) << 32 | static_cast<PathKey>(this->getIndex(to));
+
+    auto const it = this->g_pathCache.find(key);
+    if (it != this->g_pathCache.end())
+    {
+        ++this->g_cacheHitCount;
+        this->g_pathCacheLru.splice(this->g_pathCacheLru.begin(), this->g_pathCacheLru, it->second._lruIt);
+        return it->second._path;
+    }
+    ++this->g_cacheMissCount;
+
+    auto const cells = this->g_pathfinder.findPath(from, to);
+
+    std::vector<fge::Vector2f> path;
+    path.reserve(cells.size());
+    for (auto const& cell: cells)
+    {
+        path.push_back(this->g_mapCache->getTileCenter(cell));
+    }
+
+    if (this->g_pathCache.size() >= F_NAV_PATH_CACHE_SIZE)
+    {
+        this->g_pathCache.erase(this->g_pathCacheLru.back());
+        this->g_pathCacheLru.pop_back();
+    }
+    this->g_pathCacheLru.push_front(key);
+    this->g_pathCache.emplace(key, CachedPath{path, this->g_pathCacheLru.begin()});
+
+    return path;
+}
+
+std::size_t Navigation::getCacheHitCount() const
+{
+    return this->g_cacheHitCount;
+}
+std::size_t Navigation::getCacheMissCount() const
+{
+    return this->g_cacheMissCount;
+}
+
+std::size_t Navigation::getIndex(fge::Vector2size const& cell) const
+{
+    return cell.y * this->g_gridSize.x + cell.x;
+}
+
+Navigation gNavigation;
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "FastEngine/C_vector.hpp"
+#include "hierarchicalPathfinder.hpp"
+#include <cstdint>
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#define F_NAV_PATH_CACHE_SIZE 128
+#define F_NAV_BAD_REGION 0xFFFFFFFF
+
+class MapCache;
+
+/*
+ * Shared navigation data of the map.
+ *
+ * The walkability grid is built once from the map cache and shared by every agent: one hierarchical path finder
+ * (clusters and entrances are precomputed so a query stays cheap on large maps), the walkable cells grouped by
+ * connected region (so a random destination is always reachable) and a LRU cache of the recent paths.
+ */
+class Navigation
+{
+public:
+    Navigation() = default;
+
+    bool build(MapCache const& mapCache);
+    void clear();
+    [[nodiscard]] bool isBuilt() const;
+
+    [[nodiscard]] uint32_t getRegion(fge::Vector2size const& cell) const;
+    //Random walkable cell in the same region as the given cell
+    [[nodiscard]] std::optional<fge::Vector2size> getRandomDestination(fge::Vector2size const& from) const;
+
+    //Path in world coordinates (tile centers), empty if there is none.
+    //Not thread-safe, when the path finding service is running only its worker must call this
+    [[nodiscard]] std::vector<fge::Vector2f> findPath(fge::Vector2size const& from, fge::Vector2size const& to);
+
+    [[nodiscard]] std::size_t getCacheHitCount() const;
+    [[nodiscard]] std::size_t getCacheMissCount() const;
+
+private:
+    using PathKey = uint64_t;
+    struct CachedPath
+    {
+        std::vector<fge::Vector2f> _path;
+        std::list<PathKey>::iterator _lruIt;
+    };
+
+    [[nodiscard]] std::size_t getIndex(fge::Vector2size const& cell) const;
+
+    MapCache const* g_mapCache{nullptr};
+    fge::Vector2size g_gridSize{0, 0};
+    HierarchicalPathfinder g_pathfinder;
+
+    std::vector<uint32_t> g_cellRegions;
+    std::vector<std::vector<fge::Vector2size>> g_regionCells;
+
+    std::unordered_map<PathKey, CachedPath> g_pathCache;
+    std::list<PathKey> g_pathCacheLru;
+    std::size_t g_cacheHitCount{0};
+    std::size_t g_cacheMissCount{0};
+};
+
+extern Navigation gNavigation;
@@ -0,0 +1,150 @@
+#include "networkThread.hpp"
+#include "../share/network.hpp"
+
+static_assert((F_NETWORK_INBOX_CAPACITY & (F_NETWORK_INBOX_CAPACITY - 1)) == 0,
+              "F_NETWORK_INBOX_CAPACITY must be a power of 2");
+
+//PacketInbox
+
+bool PacketInbox::push(InboxPacket& packet)
+{
+    auto const tail = this->g_tail.load(std::memory_order_relaxed);
+    if (tail - this->g_head.load(std::memory_order_acquire) == F_NETWORK_INBOX_CAPACITY)
+    {
+        return false;
+    }
+
+    this->g_slots[tail & (F_NETWORK_INBOX_CAPACITY - 1)] = std::move(packet);
+    this->g_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+bool PacketInbox::pop(InboxPacket& packet)
+{
+    auto const head = this->g_head.load(std::memory_order_relaxed);
+    if (head == this->g_tail.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    packet = std::move(this->g_slots[head & (F_NETWORK_INBOX_CAPACITY - 1)]);
+    this->g_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool PacketInbox::isEmpty() const
+{
+    return this->g_head.load(std::memory_order_acquire) == this->g_tail.load(std::memory_order_acquire);
+}
+void PacketInbox::clear()
+{
+    InboxPacket packet;
+    while (this->pop(packet))
+    {}
+}
+
+//NetworkThread
+
+NetworkThread::~NetworkThread()
+{
+    this->stop();
+}
+
+void NetworkThread::start(fge::net::ClientSideNetUdp& network)
+{
+    this->stop();
+
+    this->g_network = &network;
+    this->g_connectionLost = false;
+    this->g_stocLatency = std::chrono::milliseconds{0};
+    this->g_running = true;
+    this->g_thread = std::thread(&NetworkThread::run, this);
+}
+void NetworkThread::stop()
+{
+    this->g_running = false;
+    if (this->g_thread.joinable())
+    {
+        this->g_thread.join();
+    }
+
+    this->g_inbox.clear();
+    this->g_network = nullptr;
+}
+bool NetworkThread::isRunning() const
+{
+    return this->g_running;
+}
+
+bool NetworkThread::popPacket(InboxPacket& packet)
+{
+    return this->g_inbox.pop(packet);
+}
+
+void NetworkThread::notifyConnectionLost()
+{
+    this->g_connectionLost = true;
+}
+bool NetworkThread::checkConnectionLost()
+{
+    return this->g_connectionLost.exchange(false);
+}
+
+void NetworkThread::run()
+{
+    while (this->g_running && !this->g_connectionLost && this->g_network->isRunning())
+    {
+        this->g_network->waitForPackets(std::chrono::milliseconds{F_NETWORK_THREAD_WAIT_MS});
+        this->processPackets();
+    }
+}
+void NetworkThread::processPackets()
+{
+    auto& network = *this->g_network;
+
+    fge::net::ReceivedPacketPtr netPacket;
+    fge::net::FluxProcessResults processResult;
+    InboxPacket inboxPacket;
+    do {
+        processResult = network.process(netPacket);
+        if (processResult != fge::net::FluxProcessResults::USER_RETRIEVABLE)
+        {
+            continue;
+        }
+
+        switch (static_cast<PacketHeaders>(netPacket->retrieveHeaderId().value()))
+        {
+        case SERVER_UPDATE:
+            //Unpack latency planner
+            network._client._latencyPlanner.unpack(netPacket.get(), network._client);
+
+            if (auto latency = network._client._latencyPlanner.getLatency())
+            {
+                network._client.setCTOSLatency_ms(latency.value());
+            }
+            if (auto latency = network._client._latencyPlanner.getOtherSideLatency())
+            {
+                network._client.setSTOCLatency_ms(latency.value());
+                this->g_stocLatency = std::chrono::milliseconds{latency.value()};
+            }
+            break;
+        case SERVER_FULL_UPDATE:
+            break;
+        default:
+            continue;
+        }
+        network._client.getStatus().resetTimeout();
+
+        inboxPacket._packet = std::move(netPacket);
+        inboxPacket._serverTime = std::chrono::steady_clock::now() - this->g_stocLatency;
+
+        //The scene is too late, wait for it instead of losing an update
+        while (!this->g_inbox.push(inboxPacket))
+        {
+            if (!this->g_running)
+            {
+                return;
+            }
+            std::this_thread::yield();
+        }
+    } while (processResult != fge::net::FluxProcessResults::NONE_AVAILABLE && !this->g_connectionLost);
+}
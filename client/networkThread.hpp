@@ -0,0 +1,84 @@
+#pragma once
+
+#include "FastEngine/network/C_server.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+
+#define F_NETWORK_INBOX_CAPACITY 256 // Must be a power of 2
+#define F_NETWORK_THREAD_WAIT_MS 5
+
+struct InboxPacket
+{
+    fge::net::ReceivedPacketPtr _packet;
+    //Local time at which the server sent the packet (reception time minus the server to client latency)
+    std::chrono::steady_clock::time_point _serverTime{};
+};
+
+/*
+ * Single producer, single consumer lock-free queue of received packets.
+ *
+ * The producer only writes the tail and the consumer only writes the head, a slot is published with a release
+ * store of the tail and released with a release store of the head.
+ */
+class PacketInbox
+{
+public:
+    PacketInbox() = default;
+
+    //Return false when the inbox is full, the packet is then left untouched
+    bool push(InboxPacket& packet);
+    //Return false when the inbox is empty
+    [[nodiscard]] bool pop(InboxPacket& packet);
+
+    [[nodiscard]] bool isEmpty() const;
+    void clear();
+
+private:
+    std::array<InboxPacket, F_NETWORK_INBOX_CAPACITY> g_slots;
+    alignas(64) std::atomic_size_t g_head{0};
+    alignas(64) std::atomic_size_t g_tail{0};
+};
+
+/*
+ * Client network processing on its own thread.
+ *
+ * The thread waits for the packets, processes the network flux, does the latency bookkeeping and the timeout
+ * reset, then pushes the SERVER_UPDATE / SERVER_FULL_UPDATE packets into the inbox (with their estimated server
+ * time, used for the snapshot interpolation of the remote objects). The scene pops and applies
+ * them at the start of its next update, so the network timing doesn't depend on the rendering.
+ *
+ * The network callbacks (disconnection, timeout) are called on this thread, they must only notify the main thread.
+ */
+class NetworkThread
+{
+public:
+    NetworkThread() = default;
+    ~NetworkThread();
+
+    void start(fge::net::ClientSideNetUdp& network);
+    void stop();
+    [[nodiscard]] bool isRunning() const;
+
+    //Must be called from the main thread
+    [[nodiscard]] bool popPacket(InboxPacket& packet);
+
+    //Can be called from the network callbacks, the thread stops processing the network
+    void notifyConnectionLost();
+    //Return true once after the connection is lost
+    [[nodiscard]] bool checkConnectionLost();
+
+private:
+    void run();
+    void processPackets();
+
+    fge::net::ClientSideNetUdp* g_network{nullptr};
+    PacketInbox g_inbox;
+    std::chrono::milliseconds g_stocLatency{0};
+
+    std::atomic_bool g_running{false};
+    std::atomic_bool g_connectionLost{false};
+    std::thread g_thread;
+};
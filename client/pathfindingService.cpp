@@ -0,0 +1,174 @@
+#include "pathfindingService.hpp"
+#include "navigation.hpp"
+
+//Handle
+
+PathfindingService::Handle::Handle(std::shared_ptr<Request> request) :
+        g_request(std::move(request))
+{}
+PathfindingService::Handle::~Handle()
+{
+    this->cancel();
+}
+
+PathfindingService::Handle& PathfindingService::Handle::operator=(Handle&& r) noexcept
+{
+    if (this != &r)
+    {
+        this->cancel();
+        this->g_request = std::move(r.g_request);
+    }
+    return *this;
+}
+
+bool PathfindingService::Handle::isValid() const
+{
+    return this->g_request != nullptr;
+}
+bool PathfindingService::Handle::isPending() const
+{
+    return this->g_request != nullptr && this->g_request->_status != Request::Status::READY;
+}
+bool PathfindingService::Handle::isReady() const
+{
+    return this->g_request != nullptr && this->g_request->_status == Request::Status::READY;
+}
+
+std::vector<fge::Vector2f> PathfindingService::Handle::takePath()
+{
+    if (!this->isReady())
+    {
+        return {};
+    }
+    auto path = std::move(this->g_request->_path);
+    this->g_request.reset();
+    return path;
+}
+void PathfindingService::Handle::cancel()
+{
+    if (this->g_request != nullptr)
+    {
+        this->g_request->_status = Request::Status::CANCELLED;
+        this->g_request.reset();
+    }
+}
+
+//PathfindingService
+
+PathfindingService::~PathfindingService()
+{
+    this->stop();
+}
+
+void PathfindingService::start(Navigation& navigation)
+{
+    std::scoped_lock const lock(this->g_mutex);
+    if (this->g_running)
+    {
+        return;
+    }
+
+    this->g_navigation = &navigation;
+    this->g_running = true;
+    this->g_thread = std::thread(&PathfindingService::work, this);
+}
+void PathfindingService::stop()
+{
+    {
+        std::scoped_lock const lock(this->g_mutex);
+        if (!this->g_running)
+        {
+            return;
+        }
+        this->g_running = false;
+    }
+    this->g_cv.notify_all();
+
+    if (this->g_thread.joinable())
+    {
+        this->g_thread.join();
+    }
+
+    for (auto& request: this->g_pendingRequests)
+    {
+        request->_status = Request::Status::CANCELLED;
+    }
+    this->g_pendingRequests.clear();
+    this->g_computedRequests.clear();
+    this->g_navigation = nullptr;
+}
+
+PathfindingService::Handle PathfindingService::request(fge::Vector2size const& from, fge::Vector2size const& to)
+{
+    auto request = std::make_shared<Request>();
+    request->_from = from;
+    request->_to = to;
+
+    {
+        std::scoped_lock const lock(this->g_mutex);
+        if (!this->g_running)
+        { //No worker, the request is delivered empty at the next processResults()
+            request->_status = Request::Status::COMPUTED;
+            this->g_computedRequests.push_back(request);
+            return Handle{std::move(request)};
+        }
+        this->g_pendingRequests.push_back(request);
+    }
+    this->g_cv.notify_one();
+
+    return Handle{std::move(request)};
+}
+
+std::size_t PathfindingService::processResults(std::size_t maxCount)
+{
+    std::size_t count = 0;
+
+    std::scoped_lock const lock(this->g_mutex);
+    while (count < maxCount && !this->g_computedRequests.empty())
+    {
+        auto request = std::move(this->g_computedRequests.front());
+        this->g_computedRequests.pop_front();
+
+        auto expected = Request::Status::COMPUTED;
+        if (request->_status.compare_exchange_strong(expected, Request::Status::READY))
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+void PathfindingService::work()
+{
+    while (true)
+    {
+        std::shared_ptr<Request> request;
+        {
+            std::unique_lock lock(this->g_mutex);
+            this->g_cv.wait(lock, [this]() { return !this->g_running || !this->g_pendingRequests.empty(); });
+            if (!this->g_running)
+            {
+                return;
+            }
+
+            request = std::move(this->g_pendingRequests.front());
+            this->g_pendingRequests.pop_front();
+        }
+
+        if (request->_status == Request::Status::CANCELLED)
+        {
+            continue;
+        }
+
+        request->_path = this->g_navigation->findPath(request->_from, request->_to);
+
+        std::scoped_lock const lock(this->g_mutex);
+        auto expected = Request::Status::PENDING;
+        if (request->_status.compare_exchange_strong(expected, Request::Status::COMPUTED))
+        {
+            this->g_computedRequests.push_back(std::move(request));
+        }
+    }
+}
+
+PathfindingService gPathfindingService;
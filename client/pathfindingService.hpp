@@ -0,0 +1,94 @@
+#pragma once
+
+#include "FastEngine/C_vector.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#define F_PATHFINDING_RESULTS_PER_FRAME 16
+
+class Navigation;
+
+/*
+ * Asynchronous path finding.
+ *
+ * Paths are computed on a worker thread with the shared navigation data, a request returns a handle that is
+ * polled by the agent. Computed paths are delivered to their handle on the main thread by processResults(),
+ * once per frame. Destroying or cancelling a handle drops the request, if it is not computed yet it is skipped.
+ */
+class PathfindingService
+{
+    struct Request
+    {
+        enum class Status : uint8_t
+        {
+            PENDING,
+            COMPUTED,
+            READY,
+            CANCELLED
+        };
+
+        fge::Vector2size _from;
+        fge::Vector2size _to;
+        std::vector<fge::Vector2f> _path;
+        std::atomic<Status> _status{Status::PENDING};
+    };
+
+public:
+    class Handle
+    {
+    public:
+        Handle() = default;
+        Handle(Handle const& r) = delete;
+        Handle(Handle&& r) noexcept = default;
+        ~Handle();
+
+        Handle& operator=(Handle const& r) = delete;
+        Handle& operator=(Handle&& r) noexcept;
+
+        [[nodiscard]] bool isValid() const;
+        [[nodiscard]] bool isPending() const;
+        [[nodiscard]] bool isReady() const;
+
+        //Take the path of a ready request, the handle is reset
+        [[nodiscard]] std::vector<fge::Vector2f> takePath();
+        void cancel();
+
+    private:
+        friend class PathfindingService;
+        explicit Handle(std::shared_ptr<Request> request);
+
+        std::shared_ptr<Request> g_request;
+    };
+
+    PathfindingService() = default;
+    ~PathfindingService();
+
+    //The navigation findPath() must then only be used by the service
+    void start(Navigation& navigation);
+    void stop();
+
+    [[nodiscard]] Handle request(fge::Vector2size const& from, fge::Vector2size const& to);
+
+    //Must be called from the main thread, return the number of delivered paths
+    std::size_t processResults(std::size_t maxCount = F_PATHFINDING_RESULTS_PER_FRAME);
+
+private:
+    void work();
+
+    Navigation* g_navigation{nullptr};
+
+    std::deque<std::shared_ptr<Request>> g_pendingRequests;
+    std::deque<std::shared_ptr<Request>> g_computedRequests;
+
+    bool g_running = false;
+    std::mutex g_mutex;
+    std::condition_variable g_cv;
+    std::thread g_thread;
+};
+
+extern PathfindingService gPathfindingService;
@@ -0,0 +1,149 @@
+#include "snapshotInterpolation.hpp"
+#include <algorithm>
+#include <cmath>
+
+static_assert((F_SNAPSHOT_BUFFER_SIZE & (F_SNAPSHOT_BUFFER_SIZE - 1)) == 0,
+              "F_SNAPSHOT_BUFFER_SIZE must be a power of 2");
+
+namespace
+{
+
+float DurationToMs(std::chrono::steady_clock::duration duration)
+{
+    return std::chrono::duration<float, std::milli>(duration).count();
+}
+
+} // namespace
+
+//SnapshotClock
+
+void SnapshotClock::pushUpdateTime(Clock::time_point serverTime)
+{
+    if (!this->g_hasUpdate)
+    {
+        this->g_lastUpdateTime = serverTime;
+        this->g_hasUpdate = true;
+        return;
+    }
+
+    //The latency can change between 2 updates, the time must stay monotonic
+    serverTime = std::max(serverTime, this->g_lastUpdateTime);
+
+    auto const intervalMs = DurationToMs(serverTime - this->g_lastUpdateTime);
+    this->g_lastUpdateTime = serverTime;
+
+    if (this->g_intervalMs == 0.0f)
+    {
+        this->g_intervalMs = intervalMs;
+        return;
+    }
+
+    this->g_jitterMs += (std::abs(intervalMs - this->g_intervalMs) - this->g_jitterMs) / 16.0f;
+    this->g_intervalMs += (intervalMs - this->g_intervalMs) / 16.0f;
+}
+void SnapshotClock::reset()
+{
+    *this = SnapshotClock{};
+}
+
+SnapshotClock::Clock::time_point SnapshotClock::getLastUpdateTime() const
+{
+    return this->g_lastUpdateTime;
+}
+float SnapshotClock::getInterpolationDelayMs() const
+{
+    return std::clamp(this->g_intervalMs + this->g_jitterMs * F_SNAPSHOT_JITTER_FACTOR, F_SNAPSHOT_DELAY_MIN_MS,
+                      F_SNAPSHOT_DELAY_MAX_MS);
+}
+SnapshotClock::Clock::time_point SnapshotClock::getRenderTime() const
+{
+    return Clock::now() - std::chrono::duration_cast<Clock::duration>(
+                                  std::chrono::duration<float, std::milli>{this->getInterpolationDelayMs()});
+}
+
+//SnapshotBuffer
+
+void SnapshotBuffer::push(Clock::time_point time, fge::Vector2f const& position)
+{
+    if (this->g_count != 0)
+    {
+        auto const lastIndex = (this->g_next - 1) & (F_SNAPSHOT_BUFFER_SIZE - 1);
+        auto& last = this->g_snapshots[lastIndex];
+        if (time < last._time)
+        {
+            return;
+        }
+        if (time == last._time)
+        {
+            last._position = position;
+            return;
+        }
+    }
+
+    this->g_snapshots[this->g_next] = {time, position};
+    this->g_next = (this->g_next + 1) & (F_SNAPSHOT_BUFFER_SIZE - 1);
+    this->g_count = std::min<std::size_t>(this->g_count + 1, F_SNAPSHOT_BUFFER_SIZE);
+}
+void SnapshotBuffer::clear()
+{
+    this->g_next = 0;
+    this->g_count = 0;
+}
+
+bool SnapshotBuffer::isEmpty() const
+{
+    return this->g_count == 0;
+}
+SnapshotBuffer::Clock::time_point SnapshotBuffer::getLastTime() const
+{
+    return this->at(this->g_count - 1)._time;
+}
+fge::Vector2f const& SnapshotBuffer::getLastPosition() const
+{
+    return this->at(this->g_count - 1)._position;
+}
+
+fge::Vector2f SnapshotBuffer::sample(Clock::time_point renderTime) const
+{
+    if (this->g_count == 0)
+    {
+        return {};
+    }
+
+    auto const& first = this->at(0);
+    if (this->g_count == 1 || renderTime <= first._time)
+    {
+        return first._position;
+    }
+
+    auto const& last = this->at(this->g_count - 1);
+    if (renderTime >= last._time)
+    { //Late snapshots, extrapolate with the last velocity
+        auto const& previous = this->at(this->g_count - 2);
+        auto const intervalMs = DurationToMs(last._time - previous._time);
+        auto const elapsedMs = std::min(DurationToMs(renderTime - last._time), F_SNAPSHOT_EXTRAPOLATION_MAX_MS);
+        return last._position + (last._position - previous._position) * (elapsedMs / intervalMs);
+    }
+
+    //Newest snapshots are the most likely to surround the render time
+    for (std::size_t i = this->g_count - 1; i > 0; --i)
+    {
+        auto const& from = this->at(i - 1);
+        if (from._time > renderTime)
+        {
+            continue;
+        }
+
+        auto const& to = this->at(i);
+        auto const t = DurationToMs(renderTime - from._time) / DurationToMs(to._time - from._time);
+        return from._position + (to._position - from._position) * t;
+    }
+    return first._position;
+}
+
+SnapshotBuffer::Snapshot const& SnapshotBuffer::at(std::size_t index) const
+{
+    //Index 0 is the oldest snapshot
+    auto const oldest = (this->g_next - this->g_count) & (F_SNAPSHOT_BUFFER_SIZE - 1);
+    return this->g_snapshots[(oldest + index) & (F_SNAPSHOT_BUFFER_SIZE - 1)];
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "FastEngine/C_vector.hpp"
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+#define F_SNAPSHOT_BUFFER_SIZE 16 // Must be a power of 2
+#define F_SNAPSHOT_DELAY_MIN_MS 50.0f
+#define F_SNAPSHOT_DELAY_MAX_MS 500.0f
+#define F_SNAPSHOT_JITTER_FACTOR 2.0f
+#define F_SNAPSHOT_EXTRAPOLATION_MAX_MS 250.0f
+
+/*
+ * Local estimation of the server update times.
+ *
+ * Every applied SERVER_UPDATE gives its server time (the reception time minus the server to client latency of the
+ * latency planner). The interval between the updates and its jitter are smoothed (RFC 3550 estimator), the remote
+ * objects are rendered at the current time minus an interpolation delay of one interval plus some jitter,
+ * so there is almost always a newer snapshot to interpolate to.
+ */
+class SnapshotClock
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    SnapshotClock() = default;
+
+    void pushUpdateTime(Clock::time_point serverTime);
+    void reset();
+
+    [[nodiscard]] Clock::time_point getLastUpdateTime() const;
+    [[nodiscard]] float getInterpolationDelayMs() const;
+    [[nodiscard]] Clock::time_point getRenderTime() const;
+
+private:
+    Clock::time_point g_lastUpdateTime{};
+    float g_intervalMs = 0.0f;
+    float g_jitterMs = 0.0f;
+    bool g_hasUpdate = false;
+};
+
+/*
+ * Timestamped positions of a remote object.
+ *
+ * The rendered position is interpolated between the 2 snapshots around the render time, when the snapshots are
+ * late (lost packets) the last velocity is extrapolated for at most F_SNAPSHOT_EXTRAPOLATION_MAX_MS.
+ */
+class SnapshotBuffer
+{
+public:
+    using Clock = SnapshotClock::Clock;
+
+    SnapshotBuffer() = default;
+
+    //A snapshot older than the last one is ignored, a snapshot with the same time replaces it
+    void push(Clock::time_point time, fge::Vector2f const& position);
+    void clear();
+
+    [[nodiscard]] bool isEmpty() const;
+    [[nodiscard]] Clock::time_point getLastTime() const;
+    [[nodiscard]] fge::Vector2f const& getLastPosition() const;
+
+    [[nodiscard]] fge::Vector2f sample(Clock::time_point renderTime) const;
+
+private:
+    struct Snapshot
+    {
+        Clock::time_point _time{};
+        fge::Vector2f _position;
+    };
+
+    [[nodiscard]] Snapshot const& at(std::size_t index) const;
+
+    std::array<Snapshot, F_SNAPSHOT_BUFFER_SIZE> g_snapshots{};
+    std::size_t g_next = 0;
+    std::size_t g_count = 0;
+};
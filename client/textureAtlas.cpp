@@ -0,0 +1,106 @@
+#include "textureAtlas.hpp"
+#include "FastEngine/manager/texture_manager.hpp"
+#include "SDL.h"
+#include <algorithm>
+#include <iostream>
+
+TextureAtlas::TextureAtlas(std::string name) :
+        g_name(std::move(name))
+{}
+
+bool TextureAtlas::build(std::vector<Sprite> const& sprites)
+{
+    this->g_rects.clear();
+    this->g_surface.reset();
+
+    std::vector<std::pair<std::string const*, std::unique_ptr<fge::Surface>>> surfaces;
+    surfaces.reserve(sprites.size());
+    for (auto const& sprite: sprites)
+    {
+        auto surface = std::make_unique<fge::Surface>();
+        if (!surface->loadFromFile(sprite._path))
+        {
+            std::cout << "Can't load atlas sprite " << sprite._path << "\n";
+            continue;
+        }
+        surfaces.emplace_back(&sprite._name, std::move(surface));
+    }
+
+    //Shelf packing, higher sprites first
+    std::ranges::sort(surfaces,
+                      [](auto const& a, auto const& b) { return a.second->getSize().y > b.second->getSize().y; });
+
+    int atlasWidth = F_ATLAS_WIDTH;
+    for (auto const& [name, surface]: surfaces)
+    {
+        atlasWidth = std::max(atlasWidth, static_cast<int>(surface->getSize().x) + F_ATLAS_PADDING * 2);
+    }
+
+    fge::Vector2i cursor{F_ATLAS_PADDING, F_ATLAS_PADDING};
+    int shelfHeight = 0;
+    for (auto const& [name, surface]: surfaces)
+    {
+        fge::Vector2i const size{static_cast<int>(surface->getSize().x), static_cast<int>(surface->getSize().y)};
+        if (cursor.x + size.x + F_ATLAS_PADDING > atlasWidth)
+        {
+            cursor = {F_ATLAS_PADDING, cursor.y + shelfHeight + F_ATLAS_PADDING};
+            shelfHeight = 0;
+        }
+
+        this->g_rects[*name] = fge::RectInt{cursor, size};
+        cursor.x += size.x + F_ATLAS_PADDING;
+        shelfHeight = std::max(shelfHeight, size.y);
+    }
+    int const atlasHeight = cursor.y + shelfHeight + F_ATLAS_PADDING;
+
+    auto* atlasSurface = SDL_CreateRGBSurfaceWithFormat(0, atlasWidth, atlasHeight, 32, SDL_PIXELFORMAT_RGBA32);
+    if (atlasSurface == nullptr)
+    {
+        std::cout << "Can't create the atlas " << this->g_name << ": " << SDL_GetError() << "\n";
+        this->g_rects.clear();
+        return false;
+    }
+    this->g_surface = std::make_unique<fge::Surface>(atlasSurface);
+
+    for (auto const& [name, surface]: surfaces)
+    {
+        auto const& rect = this->g_rects[*name];
+        SDL_Rect destination{rect._x, rect._y, rect._width, rect._height};
+
+        //Copy the pixels as is, including the alpha
+        SDL_SetSurfaceBlendMode(surface->get(), SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(surface->get(), nullptr, this->g_surface->get(), &destination);
+    }
+
+    return true;
+}
+std::unique_ptr<fge::Surface> TextureAtlas::releaseSurface()
+{
+    return std::move(this->g_surface);
+}
+
+std::string const& TextureAtlas::getName() const
+{
+    return this->g_name;
+}
+fge::RectInt TextureAtlas::getRect(std::string const& spriteName) const
+{
+    auto const it = this->g_rects.find(spriteName);
+    if (it == this->g_rects.end())
+    {
+        return fge::RectInt{{0, 0}, {FGE_TEXTURE_BAD_W, FGE_TEXTURE_BAD_H}};
+    }
+    return it->second;
+}
+fge::RectInt TextureAtlas::getRect(std::string const& spriteName, fge::RectInt const& subRect) const
+{
+    auto rect = this->getRect(spriteName);
+    rect._x += subRect._x;
+    rect._y += subRect._y;
+    rect._width = subRect._width;
+    rect._height = subRect._height;
+    return rect;
+}
+
+TextureAtlas gFishAtlas{F_ATLAS_FISH};
+TextureAtlas gCollectionAtlas{F_ATLAS_COLLECTION};
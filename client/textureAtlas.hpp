@@ -0,0 +1,50 @@
+#pragma once
+
+#include "FastEngine/C_rect.hpp"
+#include "FastEngine/C_surface.hpp"
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#define F_ATLAS_FISH "fishAtlas"
+#define F_ATLAS_COLLECTION "collectionAtlas"
+
+#define F_ATLAS_WIDTH 256
+#define F_ATLAS_PADDING 1
+
+/*
+ * Runtime texture atlas.
+ *
+ * Sprites are packed with a simple shelf packer (sorted by height) into one surface, that is then uploaded
+ * as a single texture named after the atlas. Sprites are then drawn with the atlas texture and their packed rect.
+ */
+class TextureAtlas
+{
+public:
+    struct Sprite
+    {
+        std::string _name;
+        std::filesystem::path _path;
+    };
+
+    explicit TextureAtlas(std::string name);
+
+    //Decode and pack the sprites, can be called from a worker thread
+    bool build(std::vector<Sprite> const& sprites);
+    [[nodiscard]] std::unique_ptr<fge::Surface> releaseSurface();
+
+    [[nodiscard]] std::string const& getName() const;
+    [[nodiscard]] fge::RectInt getRect(std::string const& spriteName) const;
+    //Get a part of a sprite, the sub rect is relative to the original sprite
+    [[nodiscard]] fge::RectInt getRect(std::string const& spriteName, fge::RectInt const& subRect) const;
+
+private:
+    std::string g_name;
+    std::unique_ptr<fge::Surface> g_surface;
+    std::unordered_map<std::string, fge::RectInt> g_rects;
+};
+
+extern TextureAtlas gFishAtlas;
+extern TextureAtlas gCollectionAtlas;
@@ -0,0 +1,67 @@
+#include "clientSnapshot.hpp"
+#include <algorithm>
+
+ClientSnapshot::ClientSnapshot() :
+        g_list(std::make_shared<List const>())
+{}
+
+void ClientSnapshot::add(fge::net::Identity const& identity, fge::net::ClientSharedPtr const& client)
+{
+    std::scoped_lock const writeLock(this->g_writeMutex);
+
+    auto newList = std::make_shared<List>(*this->get());
+
+    auto const it = std::find_if(newList->begin(), newList->end(),
+                                 [&](Entry const& entry) { return entry._identity == identity; });
+    if (it != newList->end())
+    {
+        it->_client = client;
+    }
+    else
+    {
+        newList->push_back({identity, client});
+    }
+
+    this->publish(std::move(newList));
+}
+void ClientSnapshot::remove(fge::net::Identity const& identity)
+{
+    std::scoped_lock const writeLock(this->g_writeMutex);
+
+    auto const currentList = this->get();
+    auto const it = std::find_if(currentList->begin(), currentList->end(),
+                                 [&](Entry const& entry) { return entry._identity == identity; });
+    if (it == currentList->end())
+    {
+        return;
+    }
+
+    auto newList = std::make_shared<List>();
+    newList->reserve(currentList->size() - 1);
+    for (auto const& entry: *currentList)
+    {
+        if (entry._identity != identity)
+        {
+            newList->push_back(entry);
+        }
+    }
+
+    this->publish(std::move(newList));
+}
+void ClientSnapshot::clear()
+{
+    std::scoped_lock const writeLock(this->g_writeMutex);
+    this->publish(std::make_shared<List const>());
+}
+
+ClientSnapshot::ListPtr ClientSnapshot::get() const
+{
+    std::scoped_lock const lock(this->g_publishMutex);
+    return this->g_list;
+}
+
+void ClientSnapshot::publish(ListPtr list)
+{
+    std::scoped_lock const lock(this->g_publishMutex);
+    this->g_list = std::move(list);
+}
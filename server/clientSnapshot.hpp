@@ -0,0 +1,39 @@
+#pragma once
+
+#include "FastEngine/network/C_server.hpp"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*
+ * Copy-on-write list of the authenticated clients.
+ *
+ * Readers get an immutable version of the list and can iterate it without holding any lock,
+ * writers copy the current version, modify it and publish the new one.
+ */
+class ClientSnapshot
+{
+public:
+    struct Entry
+    {
+        fge::net::Identity _identity;
+        fge::net::ClientSharedPtr _client;
+    };
+    using List = std::vector<Entry>;
+    using ListPtr = std::shared_ptr<List const>;
+
+    ClientSnapshot();
+
+    void add(fge::net::Identity const& identity, fge::net::ClientSharedPtr const& client);
+    void remove(fge::net::Identity const& identity);
+    void clear();
+
+    [[nodiscard]] ListPtr get() const;
+
+private:
+    void publish(ListPtr list);
+
+    mutable std::mutex g_publishMutex;
+    std::mutex g_writeMutex;
+    ListPtr g_list;
+};
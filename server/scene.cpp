@@ -0,0 +1,720 @@
+#include "scene.hpp"
+#include "FastEngine/C_clock.hpp"
+#include "FastEngine/C_random.hpp"
+#include "FastEngine/manager/reg_manager.hpp"
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+std::atomic_bool gRunning = true;
+
+//Scene
+
+Scene::Scene()
+{
+    //Events are pushed to the send pipeline, this one is only here to keep the same full update layout
+    this->g_playerEvents = this->_netList.push<std::remove_pointer_t<decltype(this->g_playerEvents)>>();
+}
+
+void Scene::run(fge::net::ServerSideNetUdp& network)
+{
+    nlohmann::json config;
+    if (!fge::LoadJsonFromFile("server.json", config))
+    {
+        std::cout << "Can't load server.json\n";
+        return;
+    }
+
+    fge::net::Port port = config["port"].get<fge::net::Port>();
+
+    //One socket per shard on consecutive ports, 0 means one shard per core
+    auto shardCount = config.value<unsigned int>("shards", F_NET_DEFAULT_SHARDS);
+    if (shardCount == 0)
+    {
+        shardCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    this->restoreSessions(F_SERVER_SNAPSHOT_FILE);
+
+    std::string const versioningString = F_NET_STRING_SEQ + fge::string::ToStr(F_NET_SERVER_COMPATIBILITY_VERSION);
+
+    //The clients only know the first port, they are redirected to a shard when connecting
+    this->g_basePort = port;
+    this->g_shardCount = shardCount;
+    this->g_nextShard = 0;
+
+    std::vector<fge::net::ServerSideNetUdp*> networks{&network};
+    for (unsigned int i = 1; i < shardCount; ++i)
+    {
+        networks.push_back(this->g_shards.emplace_back(std::make_unique<fge::net::ServerSideNetUdp>()).get());
+    }
+
+    for (std::size_t i = 0; i < networks.size(); ++i)
+    {
+        auto const shardPort = static_cast<fge::net::Port>(port + i);
+
+        networks[i]->setVersioningString(versioningString);
+        if (!networks[i]->start(shardPort, fge::net::IpAddress::Ipv4Any, fge::net::IpAddress::Types::Ipv4))
+        {
+            std::cout << "Can't start network on port " << shardPort << "\n";
+            for (auto* startedNetwork: networks)
+            {
+                startedNetwork->stop();
+            }
+            this->g_shards.clear();
+            return;
+        }
+
+        this->registerFluxCallbacks(*networks[i]->getDefaultFlux());
+    }
+    if (networks.size() > 1)
+    {
+        std::cout << "Network started with " << networks.size() << " shards, ports " << port << " to "
+                  << port + networks.size() - 1 << "\n";
+    }
+
+    this->g_sendPipeline.setDeadReckoningError(
+            config.value<float>("deadReckoningError", F_DEAD_RECKONING_DEFAULT_ERROR));
+    this->g_sendPipeline.start(networks);
+
+    fge::Event event;
+
+    fge::Clock mainClock;
+
+    //Init managers
+    fge::texture::gManager.initialize();
+    //fge::font::gManager.initialize();
+    //fge::shader::gManager.initialize();
+    fge::anim::gManager.initialize();
+
+    //Load object (mostly for network)
+    fge::reg::RegisterNewClass(std::make_unique<fge::reg::Stamp<Player>>());
+
+    //Load textures
+    //fge::texture::gManager.loadFromFile("OutdoorsTileset", "resources/tilesets/OutdoorsTileset.png");
+    //fge::texture::gManager.loadFromFile("fishBait_1", "resources/sprites/fishBait_1.png");
+    //fge::texture::gManager.loadFromFile("fishingFrame", "resources/sprites/fishingFrame.png");
+    //fge::texture::gManager.loadFromFile("fishingIcon", "resources/sprites/fishingIcon.png");
+    //fge::texture::gManager.loadFromFile("stars", "resources/sprites/stars.png");
+    //fge::texture::gManager.loadFromFile("hearts", "resources/sprites/hearts.png");
+
+    //Load animations
+    //fge::anim::gManager.loadFromFile("human_1", "resources/sprites/human_1.json");
+    //fge::anim::gManager.loadFromFile("ducky_1", "resources/sprites/ducky_1.json");
+
+    //Load fonts
+    //fge::font::gManager.loadFromFile("default", "resources/fonts/ttf/monogram.ttf");
+
+    //Load fishes
+    //gFishManager.loadFromFile("algae", std::nullopt, "resources/sprites/fishes/algae.png");
+    //gFishManager.loadFromFile("anchovy", std::nullopt, "resources/sprites/fishes/fish-anchovy.png");
+    //gFishManager.loadFromFile("bronze-striped-grunt", std::nullopt, "resources/sprites/fishes/fish-bronze-striped-grunt.png");
+    //gFishManager.loadFromFile("butter", std::nullopt, "resources/sprites/fishes/fish-butter.png");
+    //gFishManager.loadFromFile("gulf-croaker", std::nullopt, "resources/sprites/fishes/fish-gulf-croaker.png");
+    //gFishManager.loadFromFile("halfbeak", std::nullopt, "resources/sprites/fishes/fish-halfbeak.png");
+    //gFishManager.loadFromFile("herring", std::nullopt, "resources/sprites/fishes/fish-herring.png");
+    //gFishManager.loadFromFile("pollock", std::nullopt, "resources/sprites/fishes/fish-pollock.png");
+    //gFishManager.loadFromFile("sandlance", std::nullopt, "resources/sprites/fishes/fish-sandlance.png");
+    //gFishManager.loadFromFile("sardine", std::nullopt, "resources/sprites/fishes/fish-sardine.png");
+    //gFishManager.loadFromFile("krill", std::nullopt, "resources/sprites/fishes/krill.png");
+    //gFishManager.loadFromFile("krill-1", std::nullopt, "resources/sprites/fishes/krill-1.png");
+    //gFishManager.loadFromFile("krill-2", std::nullopt, "resources/sprites/fishes/krill-2.png");
+    //gFishManager.loadFromFile("krill-3", std::nullopt, "resources/sprites/fishes/krill-3.png");
+    //gFishManager.loadFromFile("shrimp-anemone", std::nullopt, "resources/sprites/fishes/shrimp-anemone.png");
+    //gFishManager.loadFromFile("shrimp-northern-prawn", std::nullopt, "resources/sprites/fishes/shrimp-northern-prawn.png");
+    //gFishManager.loadFromFile("squid-reef", std::nullopt, "resources/sprites/fishes/squid-reef.png");
+    //gFishManager.loadFromFile("zoo-plankton", std::nullopt, "resources/sprites/fishes/zoo-plankton.png");
+    //gFishManager.loadFromFile("zoo-plankton-small", std::nullopt, "resources/sprites/fishes/zoo-plankton-small.png");
+
+
+    std::chrono::microseconds tickTime{0};
+
+    while (gRunning)
+    {
+        std::chrono::microseconds tickDelay = std::chrono::milliseconds{F_TICK_TIME} - tickTime;
+        if (tickDelay.count() <= 0)
+        {
+            std::cout << "Can't keep up with the tick " << tickTime.count() << '\n';
+        }
+        else
+        {
+            fge::Sleep(tickDelay);
+        }
+
+        auto tickTimeStart = std::chrono::steady_clock::now();
+
+        auto const deltaTime = std::chrono::duration_cast<fge::DeltaTime>(mainClock.restart());
+
+        if (!this->g_resumableSessions.empty() && tickTimeStart >= this->g_resumeDeadline)
+        {
+            std::cout << this->g_resumableSessions.size() << " session(s) not resumed in time, discarded\n";
+            this->g_resumableSessions.clear();
+        }
+
+        //Receive packets
+        for (std::size_t i = 0; i < networks.size(); ++i)
+        {
+            this->processFlux(*networks[i]->getDefaultFlux(), i);
+        }
+
+        /**MAIN LOOP**/
+
+        ///CLIENTS CHECKUP
+        for (auto* shardNetwork: networks)
+        {
+            this->clientsCheckup(shardNetwork->getDefaultFlux()->_clients); //clients checkup
+        }
+
+        ///UPDATING SCENE
+        this->update(event, deltaTime);
+
+        ///SENDING DATA
+        this->submitTick();
+
+        for (auto* shardNetwork: networks)
+        {
+            shardNetwork->getDefaultFlux()->_clients.clearClientEvent();
+        }
+
+        //Tick time
+        tickTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() -
+                                                                         tickTimeStart);
+    }
+
+    this->g_sendPipeline.stop();
+    for (auto* shardNetwork: networks)
+    {
+        shardNetwork->stop();
+    }
+    this->g_shards.clear();
+    this->saveSessions(F_SERVER_SNAPSHOT_FILE);
+    this->g_clientSnapshot.clear();
+
+    fge::texture::gManager.uninitialize();
+    //fge::font::gManager.uninitialize();
+    //fge::shader::gManager.uninitialize();
+    fge::anim::gManager.uninitialize();
+}
+
+void Scene::registerFluxCallbacks(fge::net::ServerNetFluxUdp& flux)
+{
+    flux._clients.watchEvent(true);
+
+    //Handling clients timeout
+    flux._onClientTimeout.addLambda([this](fge::net::ClientSharedPtr client, fge::net::Identity const& id) {
+        std::cout << "client " << id.toString() << " timeout !\n";
+        this->disconnectPlayer(id);
+    });
+    flux._onClientDisconnected.addLambda([this](fge::net::ClientSharedPtr client, fge::net::Identity const& id) {
+        std::cout << "client " << id.toString() << " disconnected !\n";
+        this->disconnectPlayer(id);
+    });
+
+    //Handling clients connection
+    flux._onClientConnected.addLambda([](fge::net::ClientSharedPtr const& client, fge::net::Identity const& id) {
+        std::cout << "client " << id.toString() << " is connected and now try to authenticate !\n";
+    });
+
+    //Handling clients return packet
+    flux._onClientReturnEvent.addLambda([this](fge::net::ClientSharedPtr const& client, fge::net::Identity id,
+                                            fge::net::ReceivedPacketPtr const& packet) {
+        this->onClientReturnEvent(client, id, packet->packet());
+    });
+    flux._onClientReturnPacket.addLambda([this](fge::net::ClientSharedPtr const& client, fge::net::Identity id,
+                                             fge::net::ReceivedPacketPtr const& packet) {
+        this->onClientReturnPacket(client, id, packet->packet());
+    });
+}
+void Scene::processFlux(fge::net::ServerNetFluxUdp& flux, std::size_t shard)
+{
+    fge::net::ReceivedPacketPtr netPacket;
+    fge::net::ClientSharedPtr client;
+    fge::net::FluxProcessResults processResult;
+    do {
+        processResult = flux.process(client, netPacket);
+        if (processResult != fge::net::FluxProcessResults::USER_RETRIEVABLE)
+        {
+            continue;
+        }
+
+        switch (static_cast<PacketHeaders>(netPacket->retrieveHeaderId().value()))
+        {
+        case CLIENT_ASK_CONNECT:
+            this->onClientAskConnect(client, netPacket->getIdentity(), netPacket->packet(), shard);
+            break;
+        default:
+            break;
+        }
+    } while (processResult != fge::net::FluxProcessResults::NONE_AVAILABLE);
+}
+
+void Scene::onClientReturnEvent(fge::net::ClientSharedPtr const& client,
+                                fge::net::Identity const& id,
+                                fge::net::Packet const& packet)
+{
+    using namespace fge::net::rules;
+    auto err = RStrictLess<StatEvents>(StatEvents::EVENT_COUNT, {packet})
+                       .and_then([&](auto& chain) {
+        switch (chain.value())
+        {
+        case StatEvents::CAUGHT_FISH:
+        {
+            std::string fishName;
+            chain.packet() >> fishName;
+            if (chain.packet().isValid())
+            {
+                auto const playerId = this->getPlayerId(id);
+                std::cout << "Player " << playerId << " caught a fish " << fishName << "\n";
+                this->g_sendPipeline.pushEvent(
+                        std::make_pair(StatEvents::CAUGHT_FISH, PlayerEventData{playerId, fishName}), id);
+            }
+        }
+        break;
+        case StatEvents::PLAYER_CHAT:
+        {
+            std::string message;
+            chain.packet() >> message;
+            if (message.size() > F_NET_CHAT_MAX_SIZE)
+            {
+                std::cout << "Player " << this->getPlayerId(id) << " sent a too long message, discarded\n";
+                return chain;
+            }
+            if (chain.packet().isValid())
+            {
+                auto const playerId = this->getPlayerId(id);
+                std::cout << "Player " << playerId << " message: " << message << "\n";
+                this->g_sendPipeline.pushEvent(
+                        std::make_pair(StatEvents::PLAYER_CHAT, PlayerEventData{playerId, message}), id);
+            }
+        }
+        break;
+        }
+        return chain;
+    }).end();
+
+    if (err)
+    {
+        std::cout << "Error in client packet: \n";
+        err->dump(std::cout);
+    }
+}
+void Scene::onClientReturnPacket(fge::net::ClientSharedPtr const& client,
+                                 fge::net::Identity const& id,
+                                 fge::net::Packet const& packet)
+{
+    if (client->getStatus().getNetworkStatus() != fge::net::ClientStatus::NetworkStatus::AUTHENTICATED)
+    {
+        return;
+    }
+
+    auto playerObj = this->findPlayerObject(this->getPlayerId(id));
+
+    using namespace fge::net::rules;
+    auto err = RValid<fge::Vector2f>({packet})
+                       .and_then([&](auto& chain) {
+        playerObj->setPosition(chain.value());
+        return RValid<fge::Vector2i>(chain);
+    })
+                       .and_then([&](auto& chain) {
+        playerObj->setDirection(chain.value());
+        return RValid<Player::Stats_t>(chain);
+    })
+                       .and_then([&](auto& chain) {
+        playerObj->setState(static_cast<Player::States>(chain.value()));
+        return chain;
+    }).end();
+
+    this->g_sendPipeline.pushNeededUpdate(id, packet);
+    this->unpackNeededUpdate(packet, id);
+
+    if (err)
+    {
+        std::cout << "Error in client packet: \n";
+        err->dump(std::cout);
+        return;
+    }
+    if (!packet.endReached())
+    {
+        std::cout << "Error in client packet: Remaining data at the end of the packet\n";
+        return;
+    }
+
+    //We reset the timeout
+    client->getStatus().resetTimeout();
+}
+void Scene::onClientAskConnect(fge::net::ClientSharedPtr const& client,
+                               fge::net::Identity const& id,
+                               fge::net::Packet const& packet,
+                               std::size_t shard)
+{
+    //Check current stat
+    if (client->getStatus().getNetworkStatus() == fge::net::ClientStatus::NetworkStatus::AUTHENTICATED)
+    {
+        auto response = fge::net::CreatePacket(CLIENT_ASK_CONNECT);
+        response->doNotDiscard().doNotReorder().packet() << false << "Client already connected";
+        client->pushPacket(std::move(response));
+        return;
+    }
+
+    using namespace fge::net::rules;
+    std::string dataHello;
+    auto err = RValid(RSizeMustEqual<std::string>(sizeof(F_NET_CLIENT_HELLO) - 1, {packet, &dataHello})).end();
+
+    if (err)
+    {
+        std::cout << "Error in CLIENT_HELLO: \n";
+        err->dump(std::cout);
+        client->disconnect();
+        return;
+    }
+
+    //The session token is sent back by a reconnecting client to resume its session (empty otherwise)
+    fge::Vector2f position;
+    std::string sessionToken;
+    packet >> position >> sessionToken;
+
+    if (!packet.isValid())
+    {
+        std::cout << "Error in CLIENT_ASK_CONNECT: Invalid data\n";
+        client->disconnect();
+        return;
+    }
+    if (!packet.endReached())
+    {
+        std::cout << "Error in CLIENT_ASK_CONNECT: Remaining data at the end of the packet\n";
+        client->disconnect();
+        return;
+    }
+    if (dataHello != F_NET_CLIENT_HELLO)
+    {
+        auto response = fge::net::CreatePacket(CLIENT_ASK_CONNECT);
+        response->doNotDiscard().doNotReorder().packet() << false << "Bad strings";
+        client->pushPacket(std::move(response));
+        client->disconnect();
+    }
+
+    //Spread the clients connecting on the first port between the shards
+    if (shard == 0 && this->g_shardCount > 1)
+    {
+        auto const targetShard = this->g_nextShard;
+        this->g_nextShard = (this->g_nextShard + 1) % this->g_shardCount;
+        if (targetShard != 0)
+        {
+            auto response = fge::net::CreatePacket(CLIENT_ASK_CONNECT);
+            response->doNotDiscard().doNotReorder().packet()
+                    << false << F_NET_SERVER_REDIRECT << static_cast<fge::net::Port>(this->g_basePort + targetShard);
+            client->pushPacket(std::move(response));
+            client->disconnect();
+            return;
+        }
+    }
+
+    auto player = this->newObject<Player>();
+    player->_netList.ignoreClient(id);
+
+    auto const itSession = sessionToken.empty() ? this->g_resumableSessions.end()
+                                                : this->g_resumableSessions.find(sessionToken);
+    if (itSession != this->g_resumableSessions.end() &&
+        !this->g_playerIdentities.contains(itSession->second._playerId))
+    {
+        //Resume the previous session of this client
+        auto const& session = itSession->second;
+        this->g_playerIds[id] = session._playerId;
+        this->g_playerIdentities[session._playerId] = id;
+        this->g_sessionTokens[session._playerId] = session._sessionToken;
+
+        player->_properties["playerId"] = session._playerId;
+        player->setPosition(session._position);
+        player->setDirection(session._direction);
+        player->setState(session._state);
+        std::cout << "Client " << id.toString() << " resumed its session\n";
+    }
+    else
+    {
+        player->_properties["playerId"] = this->generatePlayerId(id);
+        player->setPosition(position);
+    }
+    if (itSession != this->g_resumableSessions.end())
+    {
+        this->g_resumableSessions.erase(itSession);
+    }
+
+    client->getStatus().setNetworkStatus(fge::net::ClientStatus::NetworkStatus::AUTHENTICATED);
+    client->getStatus().setTimeout(F_NET_CLIENT_TIMEOUT_CONNECT_MS);
+    this->g_clientSnapshot.add(id, client);
+
+    //The client is authoritative over its position, it adopts the resumed one from the response
+    auto response = fge::net::CreatePacket(CLIENT_ASK_CONNECT);
+    response->doNotDiscard().doNotReorder().packet()
+            << true << F_NET_SERVER_HELLO << player->getPosition() << player->getDirection()
+            << this->generateSessionToken(*player->_properties["playerId"].getPtr<std::string>());
+    this->packFullUpdate(id, response);
+    client->pushPacket(std::move(response));
+
+    std::cout << "Client connected " << id.toString() << "\n";
+}
+
+void Scene::submitTick()
+{
+    //Freeze the tick state, the send thread packs it while we simulate the next tick
+    auto& frame = this->g_sendPipeline.getBackFrame();
+    frame._clients = this->g_clientSnapshot.get();
+
+    fge::ObjectContainer container;
+    this->getAllObj_ByClass("FISH_PLAYER", container);
+    for (auto const& object: container)
+    {
+        auto* player = object->getObject<Player>();
+        auto const& playerId = *player->_properties["playerId"].getPtr<std::string>();
+
+        auto const itIdentity = this->g_playerIdentities.find(playerId);
+        if (itIdentity == this->g_playerIdentities.end())
+        {
+            continue;
+        }
+
+        frame._players.push_back({object->getSid(), playerId, itIdentity->second, player->getPosition(),
+                                  player->getDirection(), player->getState()});
+    }
+
+    for (auto const& [identity, currentClient]: *frame._clients)
+    {
+        if (currentClient->getStatus().getNetworkStatus() != fge::net::ClientStatus::NetworkStatus::AUTHENTICATED)
+        {
+            continue;
+        }
+
+        if (currentClient->isPendingPacketsEmpty())
+        {
+            auto packet = fge::net::CreatePacket();
+
+            /*if (clientData->_needFullUpdate) TODO: full update
+            {
+                clientData->_needFullUpdate = false;
+                packet->packet().setHeader(PRS_S_FULL_UPDATE);
+                packet->doNotDiscard();
+
+                currentClient->_latencyPlanner.pack(packet);
+
+                packet->packet() << clientData->_playerData->_player._camLocation;
+
+                scene->pack(packet->packet());
+                currentClient->pushPacket(std::move(packet));
+                continue;
+            }*/
+
+            packet->setHeaderId(SERVER_UPDATE);
+
+            //The latency planner is also used by the flux process, so it stays on this thread
+            currentClient->_latencyPlanner.pack(packet);
+
+            frame._packets.push_back({identity, currentClient, std::move(packet)});
+        }
+
+        currentClient->_data.delProperty("caughtFish");
+    }
+
+    this->g_sendPipeline.submitFrame();
+}
+
+void Scene::packFullUpdate(fge::net::Identity const& identity, fge::net::TransmitPacketPtr& packet)
+{
+    auto const yourPlayerId = this->getPlayerId(identity);
+    if (yourPlayerId.empty())
+    {
+        //Should not really happen
+        return;
+    }
+
+    packet->packet() << yourPlayerId;
+
+    //The dead-reckoning is done by the send pipeline mirror, a new client must predict from the same baseline
+    fge::ObjectContainer container;
+    this->getAllObj_ByClass("FISH_PLAYER", container);
+    for (auto const& object: container)
+    {
+        if (auto const* baseline = this->g_sendPipeline.getPlayerBaseline(object->getSid()))
+        {
+            object->getObject<Player>()->setNetworkBaseline(*baseline);
+        }
+    }
+
+    this->pack(packet->packet(), identity);
+}
+
+void Scene::disconnectPlayer(fge::net::Identity const& id)
+{
+    this->g_clientSnapshot.remove(id);
+
+    auto const playerId = this->getPlayerId(id);
+    if (playerId.empty())
+    {
+        return;
+    }
+
+    auto player = this->findPlayerObject(playerId);
+    if (player == nullptr)
+    {
+        std::cout << "Player object not found for playerId: " << playerId << "\n";
+        return;
+    }
+
+    this->delObject(player->_myObjectData.lock()->getSid());
+    this->removePlayerId(playerId);
+    this->g_sendPipeline.pushEvent(std::make_pair(StatEvents::PLAYER_DISCONNECTED, PlayerEventData{playerId, ""}),
+                                   id);
+}
+
+void Scene::saveSessions(std::filesystem::path const& path)
+{
+    std::vector<SessionSnapshot::Session> sessions;
+
+    fge::ObjectContainer container;
+    this->getAllObj_ByClass("FISH_PLAYER", container);
+    sessions.reserve(container.size());
+    for (auto const& object: container)
+    {
+        auto* player = object->getObject<Player>();
+        auto const& playerId = *player->_properties["playerId"].getPtr<std::string>();
+
+        auto const itIdentity = this->g_playerIdentities.find(playerId);
+        if (itIdentity == this->g_playerIdentities.end())
+        {
+            continue;
+        }
+
+        auto const itToken = this->g_sessionTokens.find(playerId);
+        if (itToken == this->g_sessionTokens.end())
+        {
+            continue;
+        }
+
+        sessions.push_back(
+                {playerId, itToken->second, player->getPosition(), player->getDirection(), player->getState()});
+    }
+
+    if (SessionSnapshot::save(path, sessions))
+    {
+        std::cout << "Saved " << sessions.size() << " session(s) to " << path << "\n";
+    }
+}
+void Scene::restoreSessions(std::filesystem::path const& path)
+{
+    this->g_resumableSessions.clear();
+
+    std::vector<SessionSnapshot::Session> sessions;
+    bool const loaded = SessionSnapshot::load(path, sessions);
+
+    //A snapshot is only used once
+    std::error_code err;
+    std::filesystem::remove(path, err);
+
+    if (!loaded)
+    {
+        return;
+    }
+
+    for (auto& session: sessions)
+    {
+        auto const sessionToken = session._sessionToken;
+        this->g_resumableSessions[sessionToken] = std::move(session);
+    }
+    this->g_resumeDeadline = std::chrono::steady_clock::now() + F_SERVER_SNAPSHOT_RESUME_TIME;
+
+    std::cout << "Restored " << this->g_resumableSessions.size() << " session(s) from " << path << "\n";
+}
+
+std::string const& Scene::generatePlayerId(fge::net::Identity const& identity)
+{
+    auto const it = this->g_playerIds.find(identity);
+    if (it != this->g_playerIds.end())
+    {
+        return it->second;
+    }
+
+    std::string newPlayerId;
+    do {
+        newPlayerId = fge::_random.randStr(32);
+    } while (this->g_playerIdentities.contains(newPlayerId) || this->isPlayerIdReserved(newPlayerId));
+
+    this->g_playerIds[identity] = newPlayerId;
+    this->g_playerIdentities[newPlayerId] = identity;
+    return this->g_playerIds[identity];
+}
+std::string const& Scene::generateSessionToken(std::string const& playerId)
+{
+    auto& sessionToken = this->g_sessionTokens[playerId];
+    if (sessionToken.empty())
+    {
+        sessionToken = fge::_random.randStr(32);
+    }
+    return sessionToken;
+}
+std::string Scene::getPlayerId(fge::net::Identity const& identity)
+{
+    auto const it = this->g_playerIds.find(identity);
+    if (it != this->g_playerIds.end())
+    {
+        return it->second;
+    }
+    return std::string{};
+}
+bool Scene::isPlayerIdReserved(std::string const& playerId) const
+{
+    for (auto const& [sessionToken, session]: this->g_resumableSessions)
+    {
+        if (session._playerId == playerId)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+void Scene::removePlayerId(fge::net::Identity const& identity)
+{
+    auto const it = this->g_playerIds.find(identity);
+    if (it != this->g_playerIds.end())
+    {
+        this->g_sessionTokens.erase(it->second);
+        this->g_playerIdentities.erase(it->second);
+        this->g_playerIds.erase(it);
+    }
+}
+void Scene::removePlayerId(std::string const& playerId)
+{
+    auto const it = this->g_playerIdentities.find(playerId);
+    if (it != this->g_playerIdentities.end())
+    {
+        this->g_sessionTokens.erase(playerId);
+        this->g_playerIds.erase(it->second);
+        this->g_playerIdentities.erase(it);
+    }
+}
+
+Player* Scene::findPlayerObject(std::string const& playerId) const
+{
+    fge::ObjectContainer container;
+    if (this->getAllObj_ByClass("FISH_PLAYER", container) == 0)
+    {
+        return nullptr;
+    }
+
+    for (auto const& obj: container)
+    {
+        if (obj->getObject()->_properties["playerId"] == playerId)
+        {
+            return obj->getObject<Player>();
+        }
+    }
+
+    return nullptr;
+}
+
+ClientSnapshot& Scene::getClientSnapshot()
+{
+    return this->g_clientSnapshot;
+}
+SendPipeline& Scene::getSendPipeline()
+{
+    return this->g_sendPipeline;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "FastEngine/C_scene.hpp"
+#include "FastEngine/network/C_server.hpp"
+
+#include "../share/network.hpp"
+#include "../share/player.hpp"
+#include "clientSnapshot.hpp"
+#include "sendPipeline.hpp"
+#include "sessionSnapshot.hpp"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+extern std::atomic_bool gRunning;
+
+class Scene : public fge::Scene
+{
+public:
+    Scene();
+    ~Scene() override = default;
+
+    void run(fge::net::ServerSideNetUdp& network);
+
+    void registerFluxCallbacks(fge::net::ServerNetFluxUdp& flux);
+    void processFlux(fge::net::ServerNetFluxUdp& flux, std::size_t shard);
+
+    void onClientReturnEvent(fge::net::ClientSharedPtr const& client,
+                             fge::net::Identity const& id,
+                             fge::net::Packet const& packet);
+    void onClientReturnPacket(fge::net::ClientSharedPtr const& client,
+                              fge::net::Identity const& id,
+                              fge::net::Packet const& packet);
+    void onClientAskConnect(fge::net::ClientSharedPtr const& client,
+                            fge::net::Identity const& id,
+                            fge::net::Packet const& packet,
+                            std::size_t shard);
+
+    void submitTick();
+
+    void packFullUpdate(fge::net::Identity const& identity, fge::net::TransmitPacketPtr& packet);
+
+    void disconnectPlayer(fge::net::Identity const& id);
+
+    void saveSessions(std::filesystem::path const& path);
+    void restoreSessions(std::filesystem::path const& path);
+
+    std::string const& generatePlayerId(fge::net::Identity const& identity);
+    //Secret token that a client sends back to resume its session after a server restart
+    std::string const& generateSessionToken(std::string const& playerId);
+    std::string getPlayerId(fge::net::Identity const& identity);
+    [[nodiscard]] bool isPlayerIdReserved(std::string const& playerId) const;
+    void removePlayerId(fge::net::Identity const& identity);
+    void removePlayerId(std::string const& playerId);
+
+    Player* findPlayerObject(std::string const& playerId) const;
+
+    [[nodiscard]] ClientSnapshot& getClientSnapshot();
+    [[nodiscard]] SendPipeline& getSendPipeline();
+
+private:
+    std::unordered_map<fge::net::Identity, std::string, fge::net::IdentityHash> g_playerIds;
+    std::unordered_map<std::string, fge::net::Identity> g_playerIdentities;
+    fge::net::NetworkTypeEvents<StatEvents, PlayerEventData>* g_playerEvents{nullptr};
+    ClientSnapshot g_clientSnapshot;
+    SendPipeline g_sendPipeline;
+
+    //Player id -> session token
+    std::unordered_map<std::string, std::string> g_sessionTokens;
+
+    //Sessions restored from a snapshot keyed by session token, waiting for their client to reconnect
+    std::unordered_map<std::string, SessionSnapshot::Session> g_resumableSessions;
+    std::chrono::steady_clock::time_point g_resumeDeadline;
+
+    //Extra sockets when the server is sharded, the first one is the network given to run()
+    std::vector<std::unique_ptr<fge::net::ServerSideNetUdp>> g_shards;
+    fge::net::Port g_basePort{0};
+    std::size_t g_shardCount{1};
+    std::size_t g_nextShard{0};
+};
@@ -0,0 +1,227 @@
+#include "sendPipeline.hpp"
+
+//SendPipeline::Frame
+
+void SendPipeline::Frame::clear()
+{
+    this->_clients.reset();
+    this->_players.clear();
+    this->_events.clear();
+    this->_neededUpdates.clear();
+    this->_packets.clear();
+    this->_baselines.clear();
+}
+
+//SendPipeline
+
+SendPipeline::SendPipeline()
+{
+    this->g_mirrorPlayerEvents =
+            this->g_mirrorScene._netList.push<std::remove_pointer_t<decltype(this->g_mirrorPlayerEvents)>>();
+    this->g_mirrorClients.watchEvent(true);
+}
+SendPipeline::~SendPipeline()
+{
+    this->stop();
+}
+
+void SendPipeline::setDeadReckoningError(float maxError)
+{
+    this->g_deadReckoningError = maxError;
+}
+
+void SendPipeline::start(std::vector<fge::net::ServerSideNetUdp*> networks)
+{
+    this->stop();
+
+    this->g_networks = std::move(networks);
+    this->g_pending = false;
+    this->g_running = true;
+    this->g_thread = std::thread(&SendPipeline::run, this);
+}
+void SendPipeline::stop()
+{
+    {
+        std::scoped_lock const lock(this->g_mutex);
+        this->g_running = false;
+    }
+    this->g_cv.notify_all();
+
+    if (this->g_thread.joinable())
+    {
+        this->g_thread.join();
+    }
+
+    for (auto& frame: this->g_frames)
+    {
+        frame.clear();
+    }
+    this->g_mirrorScene.delAllObject(true);
+    this->g_mirrorClients.clear();
+    this->g_mirroredIdentities.clear();
+    this->g_playerBaselines.clear();
+}
+
+SendPipeline::Frame& SendPipeline::getBackFrame()
+{
+    return this->g_frames[this->g_backIndex];
+}
+void SendPipeline::pushEvent(std::pair<StatEvents, PlayerEventData> event, fge::net::Identity const& ignoredIdentity)
+{
+    this->getBackFrame()._events.push_back({std::move(event), ignoredIdentity});
+}
+void SendPipeline::pushNeededUpdate(fge::net::Identity const& identity, fge::net::Packet const& packet)
+{
+    this->getBackFrame()._neededUpdates.push_back({identity, packet});
+}
+Player::NetworkBaseline const* SendPipeline::getPlayerBaseline(fge::ObjectSid sid) const
+{
+    auto const it = this->g_playerBaselines.find(sid);
+    return it != this->g_playerBaselines.end() ? &it->second : nullptr;
+}
+
+void SendPipeline::submitFrame()
+{
+    {
+        std::unique_lock lock(this->g_mutex);
+        this->g_cv.wait(lock, [&]() { return !this->g_pending || !this->g_running; });
+        if (!this->g_running)
+        {
+            this->getBackFrame().clear();
+            return;
+        }
+
+        this->g_pending = true;
+        this->g_backIndex ^= 1;
+    }
+    this->g_cv.notify_all();
+
+    //The send thread is done with this one, keep its dead-reckoning baselines for the full updates
+    auto& doneFrame = this->getBackFrame();
+    this->g_playerBaselines.clear();
+    for (auto const& [sid, baseline]: doneFrame._baselines)
+    {
+        this->g_playerBaselines[sid] = baseline;
+    }
+    doneFrame.clear();
+}
+
+void SendPipeline::waitIdle()
+{
+    std::unique_lock lock(this->g_mutex);
+    this->g_cv.wait(lock, [&]() { return !this->g_pending || !this->g_running; });
+}
+
+void SendPipeline::run()
+{
+    std::unique_lock lock(this->g_mutex);
+    while (true)
+    {
+        this->g_cv.wait(lock, [&]() { return this->g_pending || !this->g_running; });
+        if (!this->g_pending)
+        {
+            break;
+        }
+
+        auto& frame = this->g_frames[this->g_backIndex ^ 1];
+        lock.unlock();
+
+        this->sendFrame(frame);
+
+        lock.lock();
+        this->g_pending = false;
+        this->g_cv.notify_all();
+    }
+}
+
+void SendPipeline::sendFrame(Frame& frame)
+{
+    //Mirror the players state
+    this->g_mirroredSids.clear();
+    for (auto const& state: frame._players)
+    {
+        this->g_mirroredSids.insert(state._sid);
+
+        Player* player = nullptr;
+        if (auto const object = this->g_mirrorScene.getObject(state._sid))
+        {
+            player = object->getObject<Player>();
+        }
+        else
+        {
+            auto const newObject =
+                    this->g_mirrorScene.newObject(FGE_NEWOBJECT(Player), FGE_SCENE_PLAN_DEFAULT, state._sid);
+            player = newObject->getObject<Player>();
+            player->_properties["playerId"] = state._playerId;
+            player->_netList.ignoreClient(state._owner);
+        }
+
+        player->setPosition(state._position);
+        player->setDirection(state._direction);
+        player->setState(state._state);
+        //Only send the position when the clients can't predict it
+        player->updateDeadReckoning(this->g_deadReckoningError, static_cast<float>(F_TICK_TIME) / 1000.0f);
+        frame._baselines.push_back({state._sid, player->getNetworkBaseline()});
+    }
+
+    fge::ObjectContainer container;
+    this->g_mirrorScene.getAllObj_ByClass("FISH_PLAYER", container);
+    for (auto const& object: container)
+    {
+        if (!this->g_mirroredSids.contains(object->getSid()))
+        {
+            this->g_mirrorScene.delObject(object->getSid());
+        }
+    }
+
+    //Mirror the client list
+    std::unordered_set<fge::net::Identity, fge::net::IdentityHash> frameIdentities;
+    for (auto const& [identity, client]: *frame._clients)
+    {
+        frameIdentities.insert(identity);
+        if (!this->g_mirroredIdentities.contains(identity))
+        {
+            this->g_mirrorClients.add(identity, client);
+            this->g_mirroredIdentities.insert(identity);
+        }
+    }
+    for (auto it = this->g_mirroredIdentities.begin(); it != this->g_mirroredIdentities.end();)
+    {
+        if (!frameIdentities.contains(*it))
+        {
+            this->g_mirrorClients.remove(*it);
+            it = this->g_mirroredIdentities.erase(it);
+            continue;
+        }
+        ++it;
+    }
+
+    this->g_mirrorScene.clientsCheckup(this->g_mirrorClients);
+
+    for (auto& neededUpdate: frame._neededUpdates)
+    {
+        this->g_mirrorScene.unpackNeededUpdate(neededUpdate._packet, neededUpdate._identity);
+    }
+    for (auto& event: frame._events)
+    {
+        this->g_mirrorPlayerEvents->pushEventIgnore(std::move(event._event), event._ignoredIdentity);
+    }
+
+    //Pack and send
+    for (auto& [identity, client, packet]: frame._packets)
+    {
+        this->g_mirrorScene.packModification(packet->packet(), identity);
+        //this->g_mirrorScene.packWatchedEvent(packet->packet(), identity);
+
+        client->pushPacket(std::move(packet));
+    }
+    if (!frame._packets.empty())
+    {
+        for (auto* network: this->g_networks)
+        {
+            network->notifyTransmission();
+        }
+    }
+
+    this->g_mirrorClients.clearClientEvent();
+}
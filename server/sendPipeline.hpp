@@ -0,0 +1,115 @@
+#pragma once
+
+#include "FastEngine/C_scene.hpp"
+#include "FastEngine/network/C_server.hpp"
+
+#include "../share/network.hpp"
+#include "../share/player.hpp"
+#include "clientSnapshot.hpp"
+#include <array>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/*
+ * Double-buffered send stage of the server tick.
+ *
+ * The simulation thread fills the back frame with a frozen copy of the tick N world state while the send thread
+ * packs and pushes the front frame (tick N-1) from its own mirror scene.
+ * The per-tick wall time then becomes max(simulate, send) instead of their sum.
+ */
+class SendPipeline
+{
+public:
+    struct PlayerState
+    {
+        fge::ObjectSid _sid;
+        std::string _playerId;
+        fge::net::Identity _owner;
+        fge::Vector2f _position;
+        fge::Vector2i _direction;
+        Player::States _state;
+    };
+    struct PlayerEvent
+    {
+        std::pair<StatEvents, PlayerEventData> _event;
+        fge::net::Identity _ignoredIdentity;
+    };
+    struct NeededUpdate
+    {
+        fge::net::Identity _identity;
+        fge::net::Packet _packet;
+    };
+    struct PlayerBaseline
+    {
+        fge::ObjectSid _sid;
+        Player::NetworkBaseline _baseline;
+    };
+    struct ClientPacket
+    {
+        fge::net::Identity _identity;
+        fge::net::ClientSharedPtr _client;
+        fge::net::TransmitPacketPtr _packet;
+    };
+
+    struct Frame
+    {
+        ClientSnapshot::ListPtr _clients;
+        std::vector<PlayerState> _players;
+        std::vector<PlayerEvent> _events;
+        std::vector<NeededUpdate> _neededUpdates;
+        std::vector<ClientPacket> _packets;
+        //Filled by the send thread
+        std::vector<PlayerBaseline> _baselines;
+
+        void clear();
+    };
+
+    SendPipeline();
+    ~SendPipeline();
+
+    //Maximum distance between the real and the client predicted position of a player, must be set before start()
+    void setDeadReckoningError(float maxError);
+
+    void start(std::vector<fge::net::ServerSideNetUdp*> networks);
+    void stop();
+
+    //Only accessed by the simulation thread, this is the frame for the current tick
+    [[nodiscard]] Frame& getBackFrame();
+    void pushEvent(std::pair<StatEvents, PlayerEventData> event, fge::net::Identity const& ignoredIdentity);
+    void pushNeededUpdate(fge::net::Identity const& identity, fge::net::Packet const& packet);
+    //Dead-reckoning baseline of a player in the last sent frame, the full updates must carry it
+    [[nodiscard]] Player::NetworkBaseline const* getPlayerBaseline(fge::ObjectSid sid) const;
+
+    //Wait for the send thread to finish the previous frame and hand over the back frame
+    void submitFrame();
+    //Wait for the send thread to finish the last submitted frame
+    void waitIdle();
+
+private:
+    void run();
+    void sendFrame(Frame& frame);
+
+    std::vector<fge::net::ServerSideNetUdp*> g_networks;
+    float g_deadReckoningError = F_DEAD_RECKONING_DEFAULT_ERROR;
+
+    fge::Scene g_mirrorScene;
+    fge::net::NetworkTypeEvents<StatEvents, PlayerEventData>* g_mirrorPlayerEvents{nullptr};
+    fge::net::ClientList g_mirrorClients;
+    std::unordered_set<fge::ObjectSid> g_mirroredSids;
+    std::unordered_set<fge::net::Identity, fge::net::IdentityHash> g_mirroredIdentities;
+
+    //Only accessed by the simulation thread
+    std::unordered_map<fge::ObjectSid, Player::NetworkBaseline> g_playerBaselines;
+
+    std::array<Frame, 2> g_frames;
+    std::size_t g_backIndex = 0;
+    bool g_pending = false;
+    bool g_running = false;
+    std::mutex g_mutex;
+    std::condition_variable g_cv;
+    std::thread g_thread;
+};
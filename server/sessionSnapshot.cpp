@@ -0,0 +1,116 @@
+#include "sessionSnapshot.hpp"
+#include "../share/network.hpp"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+
+int64_t GetNowSeconds()
+{
+    return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch())
+            .count();
+}
+
+} // namespace
+
+bool SessionSnapshot::save(std::filesystem::path const& path, std::vector<Session> const& sessions)
+{
+    fge::net::Packet packet;
+    packet << std::string{F_SERVER_SNAPSHOT_MAGIC} << F_SERVER_SNAPSHOT_VERSION << F_NET_SERVER_COMPATIBILITY_VERSION
+           << GetNowSeconds() << static_cast<uint32_t>(sessions.size());
+
+    for (auto const& session: sessions)
+    {
+        packet << session._playerId << session._sessionToken << session._position << session._direction
+               << static_cast<Player::Stats_t>(session._state);
+    }
+
+    //The snapshot is replaced at once, it is never half written
+    auto tmpPath = path;
+    tmpPath += ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            std::cout << "Can't open the snapshot file " << tmpPath << " for writing\n";
+            return false;
+        }
+
+        file.write(reinterpret_cast<char const*>(packet.getData()),
+                   static_cast<std::streamsize>(packet.getDataSize()));
+        if (!file.flush())
+        {
+            std::cout << "Can't write the snapshot file " << tmpPath << "\n";
+            return false;
+        }
+    }
+
+    std::error_code err;
+    std::filesystem::rename(tmpPath, path, err);
+    if (err)
+    {
+        std::cout << "Can't replace the snapshot file " << path << ": " << err.message() << "\n";
+        return false;
+    }
+    return true;
+}
+bool SessionSnapshot::load(std::filesystem::path const& path, std::vector<Session>& sessions)
+{
+    sessions.clear();
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    std::vector<uint8_t> const data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+    fge::net::Packet packet;
+    packet.append(data.data(), data.size());
+
+    std::string magic;
+    uint16_t version = 0;
+    uint32_t compatibilityVersion = 0;
+    int64_t timestamp = 0;
+    uint32_t count = 0;
+    packet >> magic >> version >> compatibilityVersion >> timestamp >> count;
+
+    if (!packet.isValid() || magic != F_SERVER_SNAPSHOT_MAGIC || version != F_SERVER_SNAPSHOT_VERSION ||
+        compatibilityVersion != F_NET_SERVER_COMPATIBILITY_VERSION)
+    {
+        std::cout << "Snapshot " << path << " is invalid or from another version, ignored\n";
+        return false;
+    }
+    if (std::chrono::seconds{GetNowSeconds() - timestamp} > F_SERVER_SNAPSHOT_MAX_AGE)
+    {
+        std::cout << "Snapshot " << path << " is too old, ignored\n";
+        return false;
+    }
+    //The count comes from the file, it is never trusted for an allocation
+    if (count > F_SERVER_SNAPSHOT_MAX_SESSIONS)
+    {
+        std::cout << "Snapshot " << path << " is corrupted, ignored\n";
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        auto& session = sessions.emplace_back();
+        Player::Stats_t state = 0;
+
+        packet >> session._playerId >> session._sessionToken >> session._position >> session._direction >> state;
+
+        if (!packet.isValid() || state > static_cast<Player::Stats_t>(Player::States::CHATTING))
+        {
+            std::cout << "Snapshot " << path << " is corrupted, ignored\n";
+            sessions.clear();
+            return false;
+        }
+        session._state = static_cast<Player::States>(state);
+    }
+
+    return true;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "FastEngine/network/C_server.hpp"
+
+#include "../share/player.hpp"
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#define F_SERVER_SNAPSHOT_FILE "server_snapshot.bin"
+#define F_SERVER_SNAPSHOT_MAGIC "FSNP"
+#define F_SERVER_SNAPSHOT_VERSION                                                                                      \
+    uint16_t                                                                                                           \
+    {                                                                                                                  \
+        2                                                                                                              \
+    }
+#define F_SERVER_SNAPSHOT_MAX_SESSIONS 65536 // A bigger count in a snapshot file means it is corrupted
+//A snapshot older than this is considered stale and is ignored
+#define F_SERVER_SNAPSHOT_MAX_AGE                                                                                      \
+    std::chrono::seconds                                                                                               \
+    {                                                                                                                  \
+        120                                                                                                            \
+    }
+//Time given to the clients to reconnect and resume their session after a restart
+#define F_SERVER_SNAPSHOT_RESUME_TIME                                                                                  \
+    std::chrono::seconds                                                                                               \
+    {                                                                                                                  \
+        60                                                                                                             \
+    }
+
+/*
+ * Compact binary snapshot of the connected players, written on shutdown and read back on start
+ * so that reconnecting clients can resume their session (same player id and state).
+ * A session is identified by a secret token given to its client at connection (the player id is public),
+ * the client sends it back when reconnecting.
+ */
+class SessionSnapshot
+{
+public:
+    struct Session
+    {
+        std::string _playerId;
+        std::string _sessionToken;
+        fge::Vector2f _position;
+        fge::Vector2i _direction;
+        Player::States _state;
+    };
+
+    [[nodiscard]] static bool save(std::filesystem::path const& path, std::vector<Session> const& sessions);
+    [[nodiscard]] static bool load(std::filesystem::path const& path, std::vector<Session>& sessions);
+};
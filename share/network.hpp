@@ -5,13 +5,15 @@
 #define F_NET_DEFAULT_IP "127.0.0.1"
 #define F_NET_DEFAULT_PORT 27421
 #define F_NET_DEFAULT_ONLINE_MODE false
+#define F_NET_DEFAULT_SHARDS 1
 #define F_NET_STRING_SEQ "ProjectFichillshGG"
 #define F_NET_CLIENT_HELLO "Hello"
 #define F_NET_SERVER_HELLO "Hi"
+#define F_NET_SERVER_REDIRECT "Redirect" // Refusal reason followed by the port of the shard to connect to
 #define F_NET_SERVER_COMPATIBILITY_VERSION                                                                             \
     uint32_t                                                                                                           \
     {                                                                                                                  \
-        1                                                                                                              \
+        3                                                                                                              \
     }
 #define F_NET_CHAT_MAX_SIZE 30
 
@@ -74,12 +76,20 @@ enum PacketHeaders : fge::net::ProtocolPacket::IdType
     /*
      * - CLIENT_HELLO
      * - PLAYER_POSITION
+     * - SESSION_TOKEN (empty for a new session)
      *
      * Response:
      * - BOOL_VALID
      * - SERVER_HELLO
+     * - PLAYER_POSITION (the resumed one, or the sent one)
+     * - PLAYER_DIRECTION
+     * - SESSION_TOKEN
      * - FULL_UPDATE
      * or
+     * - BOOL_VALID (false)
+     * - SERVER_REDIRECT
+     * - SHARD_PORT (connect again to this port)
+     * or
      * - BOOL_VALID
      * - BAD_STRING
      */
@@ -90,9 +100,10 @@ enum PacketHeaders : fge::net::ProtocolPacket::IdType
      * - LATENCY_PLANNER
      * - PLAYER_COUNT:
      * - - PLAYER_ID
-     * - - PLAYER_POSITION
+     * - - PLAYER_POSITION (dead-reckoning baseline, only sent when the prediction is wrong)
      * - - PLAYER_DIRECTION
      * - - PLAYER_STAT
+     * - - PLAYER_MOVING (the clients predict the position from the baseline while true)
      * - - EVENT_COUNT:
      * - - - EVENT_TYPE
      * - - - EVENT_DATA
@@ -108,6 +119,9 @@ enum PacketHeaders : fge::net::ProtocolPacket::IdType
      * - - PLAYER_POSITION
      * - - PLAYER_DIRECTION
      * - - PLAYER_STAT
+     * - - BASELINE_POSITION (dead-reckoning baseline of the SERVER_UPDATE)
+     * - - BASELINE_MOVING
+     * - - BASELINE_AGE (seconds since the baseline was sent)
      * - - EVENT_COUNT:
      * - - - EVENT_TYPE
      * - - - EVENT_DATA
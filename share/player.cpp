@@ -1,6 +1,8 @@
 #include "player.hpp"
 #ifndef FGE_DEF_SERVER
+    #include "../client/entityBatch.hpp"
     #include "../client/game.hpp"
+    #include "../client/mapCache.hpp"
     #include "FastEngine/manager/audio_manager.hpp"
 #else
     #include "FastEngine/C_scene.hpp"
@@ -8,6 +10,7 @@
 #include "FastEngine/C_random.hpp"
 #include "FastEngine/object/C_objTilelayer.hpp"
 #include "network.hpp"
+#include <algorithm>
 #include <iostream>
 
 //FishBait
@@ -104,37 +107,10 @@ FGE_OBJ_UPDATE_BODY(FishBait)
         if (this->g_time >= static_cast<float>(FGE_MATH_PI) / (2.0f * F_BAIT_SPEED))
         {
             //Check if the bait is in water
-            if (auto const firstLayer = scene.getFirstObj_ByTag("map"))
-            {
-                auto const map = firstLayer->getObject<fge::ObjTileLayer>()->getTileMap();
-                auto const waterLayer = map->findLayerName("Water")->get()->as<fge::TileLayer>();
-                auto const tileGrid = waterLayer->getGridPosition(this->getPosition());
-                if (!tileGrid || waterLayer->getGid(*tileGrid) == 0)
-                { //Not in water
-                    scene.delUpdatedObject();
-                    return;
-                }
-                auto const& waterTile = waterLayer->getTiles().get(*tileGrid);
-                auto const& collisionRects = waterTile.getTileData()->_collisionRects;
-
-                bool isInside = false;
-                for (auto const& rect: collisionRects)
-                {
-                    auto frect = static_cast<fge::RectFloat>(rect);
-                    frect._x += waterTile.getPosition().x;
-                    frect._y += waterTile.getPosition().y;
-                    if (frect.contains(this->getPosition()))
-                    {
-                        isInside = true;
-                        break;
-                    }
-                }
-
-                if (!isInside)
-                {
-                    scene.delUpdatedObject();
-                    return;
-                }
+            if (gMapCache.isLoaded() && !gMapCache.isWater(this->getPosition()))
+            { //Not in water
+                scene.delUpdatedObject();
+                return;
             }
 
             Mix_PlayChannel(-1, fge::audio::gManager.getElement("splash")->_ptr.get(), 0);
@@ -169,10 +145,13 @@ FGE_OBJ_UPDATE_BODY(FishBait)
 }
 FGE_OBJ_DRAW_BODY(FishBait)
 {
-    auto copyStats = states.copy();
-    copyStats._resTransform.set(target.requestGlobalTransform(*this, copyStats._resTransform));
+    //Drawn by the depth sorter entity batches, see submitSprites()
+}
 
-    this->g_objSprite.draw(target, copyStats);
+void FishBait::submitSprites(EntityBatch& batch) const
+{
+    batch.submit("fishBait_1", this->g_objSprite.getTextureRect(), this->g_objSprite, this->getPosition(),
+                 this->g_objSprite.getColor());
 }
 #endif //FGE_DEF_SERVER
 
@@ -183,6 +162,10 @@ void FishBait::first(fge::Scene& scene)
     this->g_objSprite.scale(0.9f);
     this->g_startPosition = this->getPosition();
     this->_netSyncMode = NetSyncModes::NO_SYNC;
+#ifndef FGE_DEF_SERVER
+    gGameHandler->getDepthSorter().add(this->_myObjectData.lock(), 0.0f,
+                                       [this](EntityBatch& batch) { this->submitSprites(batch); });
+#endif
 }
 
 void FishBait::callbackRegister(fge::Event& event, fge::GuiElementHandler* guiElementHandlerPtr) {}
@@ -327,17 +310,33 @@ FGE_OBJ_UPDATE_BODY(Player)
 FGE_OBJ_UPDATE_BODY(Player)
 {
     FGE_OBJ_UPDATE_CALL(this->g_objAnim);
-    FGE_OBJ_UPDATE_CALL(this->g_objAnimShadow);
 
     if (!this->g_isUserControlled)
     {
+        //The server only sends the position when the dead-reckoning prediction is wrong, predict the others
+        auto const& snapshotClock = gGameHandler->getSnapshotClock();
+        auto const lastUpdateTime = snapshotClock.getLastUpdateTime();
+        if (!this->g_snapshots.isEmpty() && lastUpdateTime > this->g_snapshots.getLastTime())
+        {
+            auto const predictionTime =
+                    std::chrono::duration<float>(lastUpdateTime - this->g_serverPositionTime).count();
+            this->g_snapshots.push(lastUpdateTime,
+                                   PredictPosition(this->g_serverPosition, this->g_direction, this->g_state,
+                                                   this->g_serverMoving, predictionTime));
+        }
+
+        auto const renderedPosition = this->g_snapshots.isEmpty()
+                                              ? this->g_serverPosition
+                                              : this->g_snapshots.sample(snapshotClock.getRenderTime());
+
         switch (this->g_state)
         {
         case States::WALKING:
         {
-            //Player movement and animation
+            //Player animation, from the rendered velocity (scaled so 0.1 is F_PLAYER_IDLE_SPEED)
             fge::Vector2i moveDirection{0, 0};
-            auto const positionDiff = this->g_serverPosition - this->getPosition();
+            auto const delta = std::max(fge::DurationToSecondFloat(deltaTime), 0.0001f);
+            auto const positionDiff = (renderedPosition - this->getPosition()) * (0.1f / F_PLAYER_IDLE_SPEED / delta);
 
             std::string animationName;
             if (positionDiff.y <= -0.1f)
@@ -391,15 +390,13 @@ FGE_OBJ_UPDATE_BODY(Player)
             }
 
             this->g_objAnim.getAnimation().setGroup(animationName);
-            this->g_objAnimShadow.getAnimation().setGroup(animationName);
             break;
         }
         default:
             break;
         }
 
-        auto const delta = fge::DurationToSecondFloat(deltaTime);
-        this->setPosition(fge::ReachVector(this->getPosition(), this->g_serverPosition, F_PLAYER_SPEED * 2.0f, delta));
+        this->setPosition(renderedPosition);
         return;
     }
 
@@ -418,8 +415,6 @@ FGE_OBJ_UPDATE_BODY(Player)
 
             this->g_objAnim.getAnimation().setGroup(animationName);
             this->g_objAnim.getAnimation().setFrame(0);
-            this->g_objAnimShadow.getAnimation().setGroup(animationName);
-            this->g_objAnimShadow.getAnimation().setFrame(0);
             this->g_fishBait = scene.newObject(FGE_NEWOBJECT(FishBait, this->g_direction, this->getPosition()));
 
             b2Body_SetLinearVelocity(this->g_bodyId, {0.0f, 0.0f});
@@ -427,7 +422,6 @@ FGE_OBJ_UPDATE_BODY(Player)
             Mix_PlayChannel(-1, fge::audio::gManager.getElement("swipe")->_ptr.get(), 0);
             this->g_state = States::THROWING;
             this->g_objAnim.getAnimation().setLoop(false);
-            this->g_objAnimShadow.getAnimation().setLoop(false);
 
             if (this->g_audioWalking != -1)
             {
@@ -493,7 +487,6 @@ FGE_OBJ_UPDATE_BODY(Player)
         b2Body_SetLinearVelocity(this->g_bodyId, {static_cast<float>(moveDirection.x) * F_PLAYER_SPEED,
                                                   static_cast<float>(moveDirection.y) * F_PLAYER_SPEED});
         this->g_objAnim.getAnimation().setGroup(animationName);
-        this->g_objAnimShadow.getAnimation().setGroup(animationName);
         break;
     }
     case States::IDLE:
@@ -510,7 +503,6 @@ FGE_OBJ_UPDATE_BODY(Player)
         {
             this->g_state = States::WALKING;
             this->g_objAnim.getAnimation().setLoop(true);
-            this->g_objAnimShadow.getAnimation().setLoop(true);
         }
         break;
     case States::FISHING:
@@ -524,70 +516,37 @@ FGE_OBJ_UPDATE_BODY(Player)
 
             this->g_state = States::WALKING;
             this->g_objAnim.getAnimation().setLoop(true);
-            this->g_objAnimShadow.getAnimation().setLoop(true);
         }
         break;
     case States::CHATTING:
         break;
     }
 
+    //Update position, the rendered position is interpolated between the last 2 physics steps
+    auto const bpos = b2Body_GetPosition(this->g_bodyId);
+    this->setPosition(gGameHandler->getInterpolatedPosition(this->g_bodyId));
+    this->g_serverPosition = {bpos.x, bpos.y};
+
     //Camera movement
     auto view = target.getView();
     view.setCenter(this->getPosition());
     target.setView(view);
-
-    //Update position
-    auto const bpos = b2Body_GetPosition(this->g_bodyId);
-    this->setPosition({bpos.x, bpos.y});
-    this->g_serverPosition = this->getPosition();
-
-    //Update plan
-    float distanceDown = std::numeric_limits<float>::max();
-    float distanceUp = std::numeric_limits<float>::max();
-    for (auto const& y: this->g_transitionYPoints)
-    {
-        auto const distance = y - (this->getPosition().y + this->g_objAnim.getOrigin().y / 2.0f);
-        if (distance > 0.0f)
-        {
-            if (distance < distanceDown)
-            {
-                distanceDown = distance;
-            }
-        }
-        else
-        {
-            if (-distance < distanceUp)
-            {
-                distanceUp = -distance;
-            }
-        }
-    }
-    distanceUp -=
-            4.0f; //TODO: this offset is here to mitigate the effect when 2 rocks are very close, find a better solution
-    if (distanceUp < distanceDown)
-    {
-        if (!this->g_transitionLast)
-        {
-            this->g_transitionLast = true;
-            scene.setObjectPlanBot(this->_myObjectData.lock()->getSid());
-        }
-    }
-    else
-    {
-        if (this->g_transitionLast)
-        {
-            this->g_transitionLast = false;
-            scene.setObjectPlanTop(this->_myObjectData.lock()->getSid());
-        }
-    }
 }
 FGE_OBJ_DRAW_BODY(Player)
 {
-    auto copyStats = states.copy();
-    copyStats._resTransform.set(target.requestGlobalTransform(*this, states._resTransform));
+    //Drawn by the depth sorter entity batches, see submitSprites()
+}
+
+void Player::submitSprites(EntityBatch& batch) const
+{
+    //The animation tileset is shared as a texture with the same name
+    auto const& textureName = this->g_objAnim.getAnimation().getName();
 
-    this->g_objAnimShadow.draw(target, copyStats);
-    this->g_objAnim.draw(target, copyStats);
+    auto const& textureRect = this->g_objAnim.getAnimation().getTextureRect();
+
+    //The shadow uses the same tileset, the black tint keeps only the texture alpha
+    batch.submit(textureName, textureRect, this->g_shadowTransform, this->getPosition(), F_PLAYER_SHADOW_COLOR);
+    batch.submit(textureName, textureRect, this->g_objAnim, this->getPosition(), this->g_objAnim.getColor());
 }
 #endif //FGE_DEF_SERVER
 
@@ -597,13 +556,13 @@ void Player::first(fge::Scene& scene)
     this->g_objAnim.getAnimation().setLoop(true);
     this->g_objAnim.centerOriginFromLocalBounds();
 
-    this->g_objAnimShadow.setAnimation(fge::Animation{"human_1_shadow", "idle_down"});
-    this->g_objAnimShadow.getAnimation().setLoop(true);
-    this->g_objAnimShadow.centerOriginFromLocalBounds();
-    this->g_objAnimShadow.setRotation(20.0f);
-    this->g_objAnimShadow.move({4.0f, 0.0f});
-    this->g_objAnimShadow.scale({0.8f, 0.7f});
-    this->g_objAnimShadow.setColor({255, 255, 255, 30});
+#ifndef FGE_DEF_SERVER
+    //The shadow is the animation frame with a fixed transform
+    this->g_shadowTransform.setOrigin(this->g_objAnim.getOrigin());
+    this->g_shadowTransform.setRotation(20.0f);
+    this->g_shadowTransform.setPosition({4.0f, 0.0f});
+    this->g_shadowTransform.setScale({0.8f, 0.7f});
+#endif
 
     this->g_objChatText->setFont("default");
     this->g_objChatText->setCharacterSize(44);
@@ -633,6 +592,7 @@ void Player::first(fge::Scene& scene)
     shapeDef.friction = 1.0f;
 
     b2CreatePolygonShape(this->g_bodyId, &shapeDef, &dynamicBox);
+    gGameHandler->registerInterpolatedBody(this->g_bodyId);
 
     if (this->_myObjectData.lock()->getContextFlags().has(fge::OBJ_CONTEXT_NETWORK))
     {
@@ -640,28 +600,9 @@ void Player::first(fge::Scene& scene)
         this->_tags.add("multiplayer");
     }
 
-    //Build layer transition lines for the player
-    this->g_transitionYPoints.clear();
-    auto const tilemap = scene.getFirstObj_ByTag("map")->getObject<fge::ObjTileLayer>()->getTileMap();
-    auto const mapDepthObjects = tilemap->findLayerName("DepthObjects")->get()->as<fge::TileLayer>();
-    fge::Vector2i tileSize{0, 0};
-    for (auto const& tile: mapDepthObjects->getTiles())
-    {
-        auto const gid = tile.getGid();
-        if (gid != FGE_LAYER_BAD_ID)
-        {
-            if (tileSize.x == 0 && tileSize.y == 0)
-            {
-                tileSize = tile.getTileSet()->getTileSize();
-            }
-
-            auto const position =
-                    mapDepthObjects->getPosition() + tile.getPosition() + static_cast<fge::Vector2f>(tileSize) / 2.0f;
-            this->g_transitionYPoints.emplace_back(position.y);
-        }
-    }
-    this->g_transitionPlan = tilemap->retrieveGeneratedTilelayerObject("DepthObjects")->getPlan();
-    scene.setObjectPlan(this->_myObjectData.lock()->getSid(), this->g_transitionPlan);
+    //The feet of the player are used for the depth
+    gGameHandler->getDepthSorter().add(this->_myObjectData.lock(), this->g_objAnim.getOrigin().y / 2.0f,
+                                       [this](EntityBatch& batch) { this->submitSprites(batch); });
 #endif
 
     this->networkRegister();
@@ -692,18 +633,22 @@ void Player::networkRegister()
     this->_netList.clear();
 
 #ifdef FGE_DEF_SERVER
-    this->_netList.pushTrivial<fge::Vector2f>(fge::DataAccessor<fge::Vector2f>{
-            &this->getPosition(), [&](auto const& position) { this->setPosition(position); }});
+    //The server position is the dead-reckoning corrected one, see updateDeadReckoning()
+    this->_netList.pushTrivial<fge::Vector2f>(fge::DataAccessor<fge::Vector2f>{&this->g_serverPosition});
     this->_netList.pushTrivial<fge::Vector2i>(fge::DataAccessor<fge::Vector2i>{
             &this->g_direction, [&](auto const& direction) { this->setDirection(direction); }});
     this->_netList.pushTrivial<States>(fge::DataAccessor<States>{&this->g_state});
+    this->_netList.pushTrivial<bool>(fge::DataAccessor<bool>{&this->g_serverMoving});
     this->_netList.push<fge::net::NetworkTypePropertyList<std::string>>(&this->_properties, "playerId");
 #else
-    this->_netList.pushTrivial<fge::Vector2f>(fge::DataAccessor<fge::Vector2f>{&this->g_serverPosition});
+    this->_netList.pushTrivial<fge::Vector2f>(fge::DataAccessor<fge::Vector2f>{
+            &this->g_serverPosition, [&](auto const& position) { this->setServerPosition(position); }});
     this->_netList.pushTrivial<fge::Vector2i>(fge::DataAccessor<fge::Vector2i>{
             &this->g_direction, [&](auto const& direction) { this->setServerDirection(direction); }});
     this->_netList.pushTrivial<States>(
             fge::DataAccessor<States>{&this->g_state, [&](auto const& stat) { this->setServerState(stat); }});
+    this->_netList.pushTrivial<bool>(
+            fge::DataAccessor<bool>{&this->g_serverMoving, [&](auto const& moving) { this->setServerMoving(moving); }});
     this->_netList.push<fge::net::NetworkTypePropertyList<std::string>>(&this->_properties, "playerId")
             ->needExplicitUpdate();
 #endif
@@ -713,6 +658,12 @@ void Player::pack(fge::net::Packet& pck)
 {
     pck << this->getPosition() << this->g_direction << this->g_state
         << *this->_properties["playerId"].getPtr<std::string>(); //TODO: a bit unsafe
+#ifdef FGE_DEF_SERVER
+    auto const baseline = this->getNetworkBaseline();
+    pck << baseline._position << baseline._moving << baseline._age;
+#else
+    pck << this->g_serverPosition << this->g_serverMoving << 0.0f;
+#endif
 }
 void Player::unpack(fge::net::Packet const& pck)
 {
@@ -720,11 +671,24 @@ void Player::unpack(fge::net::Packet const& pck)
     fge::Vector2i direction;
     States stat;
     std::string playerId;
+    NetworkBaseline baseline{};
 
-    pck >> position >> direction >> stat >> playerId;
+    pck >> position >> direction >> stat >> playerId >> baseline._position >> baseline._moving >> baseline._age;
 
     this->setPosition(position);
+#ifdef FGE_DEF_SERVER
     this->setServerPosition(position);
+#else
+    //Predict from the same baseline as the server, the next position is only sent when the prediction is wrong
+    auto const updateTime = gGameHandler->getSnapshotClock().getLastUpdateTime();
+    this->g_snapshots.clear();
+    this->g_snapshots.push(updateTime, position);
+    this->g_serverPosition = baseline._position;
+    this->g_serverPositionTime =
+            updateTime - std::chrono::duration_cast<SnapshotBuffer::Clock::duration>(
+                                 std::chrono::duration<float>{std::max(baseline._age, 0.0f)});
+    this->g_serverMoving = baseline._moving;
+#endif
     this->setServerDirection(direction);
     this->setServerState(stat);
     this->_properties["playerId"] = playerId;
@@ -766,12 +730,15 @@ void Player::setState(States state)
         b2Body_SetLinearVelocity(this->g_bodyId, {0.0f, 0.0f});
 #endif
         this->g_objAnim.getAnimation().setGroup(animationName);
-        this->g_objAnimShadow.getAnimation().setGroup(animationName);
     }
 }
 void Player::setServerPosition(fge::Vector2f const& position)
 {
     this->g_serverPosition = position;
+#ifndef FGE_DEF_SERVER
+    this->g_serverPositionTime = gGameHandler->getSnapshotClock().getLastUpdateTime();
+    this->g_snapshots.push(this->g_serverPositionTime, position);
+#endif
 }
 void Player::setServerDirection(fge::Vector2i const& direction)
 {
@@ -789,13 +756,10 @@ void Player::setServerState(States state)
 
         this->g_objAnim.getAnimation().setGroup(animationName);
         this->g_objAnim.getAnimation().setFrame(0);
-        this->g_objAnimShadow.getAnimation().setGroup(animationName);
-        this->g_objAnimShadow.getAnimation().setFrame(0);
         this->g_fishBait = scene.newObject(FGE_NEWOBJECT(FishBait, this->g_direction, this->getPosition()));
 
         this->g_state = States::THROWING;
         this->g_objAnim.getAnimation().setLoop(false);
-        this->g_objAnimShadow.getAnimation().setLoop(false);
     }
     else if ((this->g_serverState == States::CATCHING || this->g_serverState == States::FISHING ||
               this->g_serverState == States::THROWING) &&
@@ -806,7 +770,6 @@ void Player::setServerState(States state)
             scene.delObject(fishBait->getSid());
         }
         this->g_objAnim.getAnimation().setLoop(true);
-        this->g_objAnimShadow.getAnimation().setLoop(true);
     }
     else if (this->g_serverState == States::FISHING && state == States::CATCHING)
     {
@@ -819,6 +782,86 @@ void Player::setServerState(States state)
     this->g_serverState = state;
     this->g_state = this->g_serverState;
 }
+#ifndef FGE_DEF_SERVER
+void Player::setServerMoving(bool moving)
+{
+    this->g_serverMoving = moving;
+}
+#endif
+
+fge::Vector2f Player::PredictPosition(fge::Vector2f const& position,
+                                      fge::Vector2i const& direction,
+                                      States state,
+                                      bool moving,
+                                      float time)
+{
+    if (!moving || state != States::WALKING)
+    {
+        return position;
+    }
+    //Same velocity as the user controlled player, the diagonals are not normalized
+    return position + static_cast<fge::Vector2f>(direction) * (F_PLAYER_SPEED * time);
+}
+#ifdef FGE_DEF_SERVER
+bool Player::updateDeadReckoning(float maxError, float tickTime)
+{
+    auto const& position = this->getPosition();
+
+    //The clients send their position at a lower rate than the tick, a stop is only detected after some time
+    if (!this->g_networkSynced)
+    {
+        this->g_lastPosition = position;
+        this->g_stillTime = F_PLAYER_STOP_DELAY;
+    }
+    else if (position != this->g_lastPosition)
+    {
+        this->g_lastPosition = position;
+        this->g_stillTime = 0.0f;
+    }
+    else
+    {
+        this->g_stillTime += tickTime;
+    }
+    this->g_networkTime += tickTime;
+
+    bool const moving = this->g_stillTime < F_PLAYER_STOP_DELAY;
+
+    //The position is compared with the prediction at the time it was received
+    auto const sampleTime = std::max(this->g_networkTime - this->g_stillTime, 0.0f);
+    auto const predictedPosition = PredictPosition(this->g_serverPosition, this->g_networkDirection,
+                                                   this->g_networkState, this->g_serverMoving, sampleTime);
+    auto const error = glm::length(predictedPosition - position);
+
+    if (this->g_networkSynced && moving == this->g_serverMoving && this->g_direction == this->g_networkDirection &&
+        this->g_state == this->g_networkState && error <= maxError)
+    {
+        return false;
+    }
+
+    this->g_serverPosition = position;
+    this->g_networkDirection = this->g_direction;
+    this->g_networkState = this->g_state;
+    this->g_serverMoving = moving;
+    this->g_networkTime = 0.0f;
+    this->g_networkSynced = true;
+    return true;
+}
+Player::NetworkBaseline Player::getNetworkBaseline() const
+{
+    if (!this->g_networkSynced)
+    {
+        return {this->getPosition(), false, 0.0f};
+    }
+    return {this->g_serverPosition, this->g_serverMoving, this->g_networkTime};
+}
+void Player::setNetworkBaseline(NetworkBaseline const& baseline)
+{
+    this->g_serverPosition = baseline._position;
+    this->g_serverMoving = baseline._moving;
+    this->g_networkTime = baseline._age;
+    this->g_networkSynced = true;
+}
+#endif
 
 void Player::startChatting([[maybe_unused]] fge::Event& event)
 {
@@ -885,6 +928,7 @@ void Player::boxMove(fge::Vector2f const& move)
 #ifndef FGE_DEF_SERVER
         b2Body_SetTransform(this->g_bodyId, {this->getPosition().x + move.x, this->getPosition().y + move.y},
                             b2MakeRot(0.0f));
+        gGameHandler->registerInterpolatedBody(this->g_bodyId); //Don't interpolate a teleport
 #endif
     }
     this->move(move);
@@ -915,7 +959,6 @@ void Player::endCatchingFish()
             this->_myObjectData.lock()->getScene()->delObject(fishBait->getSid());
         }
         this->g_objAnim.getAnimation().setLoop(true);
-        this->g_objAnimShadow.getAnimation().setLoop(true);
         this->g_state = States::WALKING;
     }
 }
@@ -928,6 +971,7 @@ void Player::allowUserControl(bool allow)
 #ifndef FGE_DEF_SERVER
         if (b2Body_IsValid(this->g_bodyId))
         {
+            gGameHandler->unregisterInterpolatedBody(this->g_bodyId);
             b2DestroyBody(this->g_bodyId);
         }
 #endif
@@ -6,10 +6,17 @@
 #include "FastEngine/object/C_objText.hpp"
 #include "FastEngine/object/C_object.hpp"
 #ifndef FGE_DEF_SERVER
+    #include "../client/snapshotInterpolation.hpp"
     #include "box2d/box2d.h"
+
+class EntityBatch;
 #endif
 
 #define F_PLAYER_SPEED 30.0f
+#define F_PLAYER_IDLE_SPEED (F_PLAYER_SPEED / 3.0f) // A slower remote player is displayed idle
+#define F_PLAYER_STOP_DELAY 0.15f // A player position unchanged for this time (s) is considered stopped
+#define F_DEAD_RECKONING_DEFAULT_ERROR 2.0f
+#define F_PLAYER_SHADOW_COLOR fge::Color(0, 0, 0, 30)
 #define F_BAIT_SPEED 2.0f
 #define F_BAIT_THROW_LENGTH 12.0f
 
@@ -79,6 +86,10 @@ public:
     void catchingFish();
     void endCatchingFish();
 
+#ifndef FGE_DEF_SERVER
+    void submitSprites(EntityBatch& batch) const;
+#endif
+
 private:
     fge::ObjSprite g_objSprite;
     fge::Vector2i g_throwDirection;
@@ -133,6 +144,14 @@ public:
     };
     using Stats_t = std::underlying_type_t<States>;
 
+    //Dead-reckoning state known by the clients, the position is the one they predict from
+    struct NetworkBaseline
+    {
+        fge::Vector2f _position;
+        bool _moving;
+        float _age; //Seconds since the position was sent
+    };
+
     Player() = default;
     ~Player() override = default;
 
@@ -162,6 +181,27 @@ public:
     void setServerPosition(fge::Vector2f const& position);
     void setServerDirection(fge::Vector2i const& direction);
     void setServerState(States state);
+#ifndef FGE_DEF_SERVER
+    void setServerMoving(bool moving);
+#endif
+
+    //Dead-reckoning model shared by the server and the clients
+    [[nodiscard]] static fge::Vector2f PredictPosition(fge::Vector2f const& position,
+                                                       fge::Vector2i const& direction,
+                                                       States state,
+                                                       bool moving,
+                                                       float time);
+#ifdef FGE_DEF_SERVER
+    /*
+     * Must be called once per tick, the network position is only corrected (and so sent) when the position
+     * predicted by the clients is too far from the real one, or when the direction, the state or the movement change.
+     * Return true when the network position is corrected.
+     */
+    bool updateDeadReckoning(float maxError, float tickTime);
+    [[nodiscard]] NetworkBaseline getNetworkBaseline() const;
+    //Used by a player that is not the dead-reckoning one (full update), to pack the baseline of the clients
+    void setNetworkBaseline(NetworkBaseline const& baseline);
+#endif
 
     void startChatting(fge::Event& event);
 
@@ -173,9 +213,12 @@ public:
 
     void allowUserControl(bool allow);
 
+#ifndef FGE_DEF_SERVER
+    void submitSprites(EntityBatch& batch) const;
+#endif
+
 private:
     fge::ObjAnimation g_objAnim;
-    fge::ObjAnimation g_objAnimShadow;
     fge::DeclareChild<fge::ObjText> g_objChatText{this};
 #ifdef FGE_DEF_SERVER
     unsigned int g_bodyId;
@@ -187,9 +230,19 @@ private:
     fge::ObjectDataWeak g_fishBait;
     fge::Vector2i g_direction{0, 1};
     fge::Vector2f g_serverPosition;
-    std::vector<float> g_transitionYPoints;
-    fge::ObjectPlan g_transitionPlan;
-    bool g_transitionLast = false;
+#ifdef FGE_DEF_SERVER
+    fge::Vector2f g_lastPosition;
+    fge::Vector2i g_networkDirection{0, 0};
+    States g_networkState = States::WALKING;
+    float g_networkTime = 0.0f;
+    float g_stillTime = 0.0f;
+    bool g_networkSynced = false;
+#else
+    fge::Transformable g_shadowTransform;
+    SnapshotBuffer g_snapshots;
+    SnapshotBuffer::Clock::time_point g_serverPositionTime{};
+#endif
+    bool g_serverMoving = false;
     int g_audioWalking = -1;
     bool g_isUserControlled = true;
 };
\ No newline at end of file
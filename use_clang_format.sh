@@ -9,3 +9,6 @@ find server/ -iname *.hpp -o -iname *.cpp -o -iname *.inl |
 
 find share/ -iname *.hpp -o -iname *.cpp -o -iname *.inl |
     xargs clang-format --style=file --verbose -i
+
+find benchmark/ -iname *.hpp -o -iname *.cpp -o -iname *.inl |
+    xargs clang-format --style=file --verbose -i
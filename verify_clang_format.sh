@@ -11,3 +11,6 @@ find server/ -iname *.hpp -o -iname *.cpp -o -iname *.inl |
 
 find share/ -iname *.hpp -o -iname *.cpp -o -iname *.inl |
     xargs clang-format --style=file --Werror --ferror-limit=1 --verbose -n
+
+find benchmark/ -iname *.hpp -o -iname *.cpp -o -iname *.inl |
+    xargs clang-format --style=file --Werror --ferror-limit=1 --verbose -n